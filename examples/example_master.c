@@ -146,20 +146,18 @@ void master_measure(char addr)
         }
     }
 
-    /* Retrieve data (may need multiple pages for >9 values) */
-    uint8_t total = 0;
-    for (uint8_t page = 0; total < mresp.value_count && page < 10; page++) {
-        sdi12_data_response_t dresp;
-        err = sdi12_master_get_data(&master, addr, page, false, &dresp);
-        if (err != SDI12_OK) break;
+    /* Retrieve data — walks aD0!, aD1!, ... and stops at value_count */
+    sdi12_data_response_t dresp;
+    err = sdi12_master_collect(&master, addr, &mresp, false, &dresp);
+    if (err != SDI12_OK) {
+        printf("Data retrieval failed (error %d)\n", err);
+    }
 
-        for (uint8_t i = 0; i < dresp.value_count; i++) {
-            printf("  Value[%d]: %.*f\n",
-                   total + i,
-                   dresp.values[i].decimals,
-                   (double)dresp.values[i].value);
-        }
-        total += dresp.value_count;
+    for (uint8_t i = 0; i < dresp.value_count; i++) {
+        printf("  Value[%d]: %.*f\n",
+               i,
+               dresp.values[i].decimals,
+               (double)dresp.values[i].value);
     }
 }
 
@@ -94,6 +94,15 @@ extern "C" {
 /** Max extended command registrations. */
 #define SDI12_MAX_XCMDS 8
 
+/** Background sample ring depth per parameter (latest + one being written). */
+#define SDI12_SAMPLE_SLOTS 2
+
+/** Max streaming statistics accumulators (see sdi12_sensor_register_stats()). */
+#define SDI12_MAX_STATS 4
+
+/** Max parameters with an attached sample history. */
+#define SDI12_MAX_HISTORY 4
+
 /** Identification string field widths per spec. */
 #define SDI12_ID_VERSION_LEN  2
 #define SDI12_ID_VENDOR_LEN   8
@@ -120,6 +129,17 @@ extern "C" {
 /** Max inter-character gap within a message. */
 #define SDI12_INTERCHAR_MAX_MS  2  /* 1.66 ms rounded up */
 
+/** Max inter-character gap within a message, in microseconds. */
+#define SDI12_INTERCHAR_MAX_US  1660
+
+/** One character at 1200 baud (start + 7 data + parity + stop), in microseconds. */
+#define SDI12_CHAR_US  8333
+
+/** Per-byte receive timeout for a recv that hands over each byte as it
+ *  arrives: one character plus the maximum inter-character gap (9.99 ms),
+ *  plus 2 ms for millisecond-tick timers. */
+#define SDI12_CHAR_GAP_MS  12
+
 /** Marking duration after which break is required. */
 #define SDI12_MARKING_TIMEOUT_MS 87
 
@@ -177,7 +197,8 @@ typedef enum {
     SDI12_ERR_TIMEOUT,
     SDI12_ERR_CRC_MISMATCH,
     SDI12_ERR_PARSE_FAILED,
-    SDI12_ERR_ABORTED
+    SDI12_ERR_ABORTED,
+    SDI12_ERR_OVERLOAD          /**< Schedule exceeds bus capacity. */
 } sdi12_err_t;
 
 /** Binary data types for high-volume binary (aHB!) responses. */
@@ -231,6 +252,21 @@ typedef struct {
     uint8_t decimals; /**< Number of decimal places to format (0–7). */
 } sdi12_value_t;
 
+/** Most decimal places a sdi12_decimal_t carries. */
+#define SDI12_DECIMAL_MAX_PLACES 9
+
+/**
+ * @brief A measurement value held exactly as integer × 10^-decimals.
+ *
+ * "+1234.567" is {1234567, 3}. Every value string SDI-12 allows (up to
+ * eight digits) fits, so text → decimal → text never changes a digit and
+ * needs no floating point. sdi12_value_t is the float convenience form.
+ */
+typedef struct {
+    int32_t mantissa; /**< Value scaled by 10^decimals. */
+    uint8_t decimals; /**< Digits after the decimal point (0–9). */
+} sdi12_decimal_t;
+
 /**
  * @brief Parsed measurement response from a sensor (master-side use).
  *
@@ -291,6 +327,34 @@ static inline bool sdi12_valid_address(char c) {
            (c >= 'a' && c <= 'z');
 }
 
+/**
+ * @brief Dense index of an address, e.g. its bit in a 64-bit bus map.
+ *
+ * '0'–'9' → 0–9, 'A'–'Z' → 10–35, 'a'–'z' → 36–61.
+ *
+ * @param c Address character.
+ * @return Index 0–61, or -1 if c is not a valid address.
+ */
+static inline int sdi12_address_index(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'z') return c - 'a' + 36;
+    return -1;
+}
+
+/**
+ * @brief Address for a dense index (inverse of sdi12_address_index()).
+ *
+ * @param i Index 0–61.
+ * @return Address character, or '\0' if i is out of range.
+ */
+static inline char sdi12_address_from_index(int i) {
+    if (i >= 0 && i < 10)  return (char)('0' + i);
+    if (i >= 10 && i < 36) return (char)('A' + i - 10);
+    if (i >= 36 && i < 62) return (char)('a' + i - 36);
+    return '\0';
+}
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  CRC API (implemented in sdi12_crc.c)                                     */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -306,6 +370,20 @@ static inline bool sdi12_valid_address(char c) {
  */
 uint16_t sdi12_crc16(const void *data, size_t len);
 
+/**
+ * @brief Continue a CRC-16-IBM over the next bytes of a message.
+ *
+ * `sdi12_crc16_update(sdi12_crc16(a, n), b, m)` equals the CRC of a
+ * followed by b, so a message can be checked piece by piece while it is
+ * being parsed. Start from 0x0000.
+ *
+ * @param crc  CRC of the bytes so far.
+ * @param data Next bytes.
+ * @param len  Number of bytes to process.
+ * @return Updated CRC.
+ */
+uint16_t sdi12_crc16_update(uint16_t crc, const void *data, size_t len);
+
 /**
  * @brief Encode a 16-bit CRC into 3 ASCII characters per SDI-12 spec.
  *
@@ -353,6 +431,101 @@ sdi12_err_t sdi12_crc_append_n(char *buf, size_t data_len, size_t buflen);
  */
 bool sdi12_crc_verify(const char *buf, size_t len);
 
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Decimal Value API (implemented in sdi12_decimal.c)                       */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * @brief Scan one sign-prefixed value ("+1.23", "-40", "+.5") into a decimal.
+ *
+ * Single pass, no locale, no floating point. Only the first
+ * SDI12_VALUE_MAX_CHARS characters are significant and a second '.' ends
+ * the number; the whole digit/point run is still consumed so the caller
+ * lands on the next sign.
+ *
+ * @param s    Text starting at the '+' or '-'.
+ * @param len  Characters available at s.
+ * @param out  Receives the value (mantissa 0 when no digits follow).
+ * @return Characters consumed, sign included: 0 if s does not start with a
+ *         sign, 1 if the sign is not followed by a digit or point.
+ */
+size_t sdi12_decimal_scan(const char *s, size_t len, sdi12_decimal_t *out);
+
+/**
+ * @brief Format a decimal with the mandatory SDI-12 sign ("+0.100", "-40").
+ *
+ * Integer arithmetic only. Leading zeros are added so the point always has
+ * a digit before it, and trailing zeros are kept.
+ *
+ * @param buf     Output buffer; null-terminated on success.
+ * @param buflen  Buffer capacity.
+ * @param d       Value to format (decimals 0–9).
+ * @return Characters written (excluding the null), or 0 if it does not fit.
+ */
+int sdi12_decimal_format(char *buf, size_t buflen, sdi12_decimal_t d);
+
+/**
+ * @brief Convert a decimal to the nearest float.
+ *
+ * Correctly rounded when the mantissa is below 2^24, which covers every
+ * SDI-12 value with a decimal point.
+ */
+float sdi12_decimal_to_float(sdi12_decimal_t d);
+
+/**
+ * @brief Round a float value to a decimal with v.decimals places.
+ *
+ * Rounds half away from zero and saturates at ±INT32_MAX; NaN becomes 0.
+ * Any float produced by sdi12_decimal_to_float() from a value of at most
+ * seven digits converts back to the same decimal.
+ */
+sdi12_decimal_t sdi12_decimal_from_value(sdi12_value_t v);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Binary Decoding API (implemented in sdi12_binary.c)                      */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Decode the size in bytes of a single binary value for a given type.
+ *
+ * @param type  Binary data type.
+ * @return Size in bytes (1–8), or 0 for invalid.
+ */
+size_t sdi12_bintype_size(sdi12_bintype_t type);
+
+/**
+ * @brief Decode a little-endian aDBn! payload of any type into floats.
+ *
+ * Correct on hosts of either byte order. int16/int32 use SSE2 or NEON
+ * where the compiler targets them; float32 is a plain copy on
+ * little-endian hosts. Wide integers round to the nearest float.
+ *
+ * @param type     Payload type from the packet header.
+ * @param payload  Raw payload bytes (any alignment).
+ * @param len      Payload bytes; a trailing partial value is ignored.
+ * @param out      [out] Decoded values.
+ * @param max      Capacity of out.
+ * @return Values written: min(len / size, max), 0 for an invalid type.
+ */
+size_t sdi12_bin_decode_float(sdi12_bintype_t type, const void *payload,
+                              size_t len, float *out, size_t max);
+
+/**
+ * @brief Decode a payload into doubles; exact for every type but 64-bit
+ *        integers beyond 2^53. Arguments as sdi12_bin_decode_float().
+ */
+size_t sdi12_bin_decode_double(sdi12_bintype_t type, const void *payload,
+                               size_t len, double *out, size_t max);
+
+/**
+ * @brief Decode a payload into int64_t. Integer types are exact (uint64
+ *        saturates at INT64_MAX); float types round to nearest, halves away
+ *        from zero, saturating, with NaN as 0. Arguments as
+ *        sdi12_bin_decode_float().
+ */
+size_t sdi12_bin_decode_int64(sdi12_bintype_t type, const void *payload,
+                              size_t len, int64_t *out, size_t max);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,249 @@
+/**
+ * @file sdi12_binary.c
+ * @brief Decoding of high-volume binary (aDBn!) payloads into typed arrays.
+ *
+ * Payloads are little-endian on the wire (§5.2). Values are assembled from
+ * bytes, so results are the same on any host; compilers turn the byte
+ * loads into plain loads on little-endian targets. int16/int32 to float
+ * have SSE2 and NEON paths and float32 to float is a straight copy on
+ * little-endian hosts, all chosen at compile time. Define SDI12_NO_SIMD to
+ * build the portable loops only.
+ */
+#include <string.h>
+#include "sdi12.h"
+
+#if !defined(SDI12_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define SDI12_BIN_SSE2    1
+#define SDI12_BIN_HOST_LE 1
+#elif !defined(SDI12_NO_SIMD) && defined(__ARM_NEON) && \
+      defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_neon.h>
+#define SDI12_BIN_NEON    1
+#define SDI12_BIN_HOST_LE 1
+#elif !defined(SDI12_NO_SIMD) && \
+      defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SDI12_BIN_HOST_LE 1
+#endif
+
+size_t sdi12_bintype_size(sdi12_bintype_t type)
+{
+    switch (type) {
+    case SDI12_BINTYPE_INT8:
+    case SDI12_BINTYPE_UINT8:   return 1;
+    case SDI12_BINTYPE_INT16:
+    case SDI12_BINTYPE_UINT16:  return 2;
+    case SDI12_BINTYPE_INT32:
+    case SDI12_BINTYPE_UINT32:
+    case SDI12_BINTYPE_FLOAT32: return 4;
+    case SDI12_BINTYPE_INT64:
+    case SDI12_BINTYPE_UINT64:
+    case SDI12_BINTYPE_FLOAT64: return 8;
+    default:                    return 0;
+    }
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Little-endian loads                                                      */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+static inline uint16_t ld16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static inline uint32_t ld32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t ld64(const uint8_t *p)
+{
+    return (uint64_t)ld32(p) | ((uint64_t)ld32(p + 4) << 32);
+}
+
+static inline float ldf32(const uint8_t *p)
+{
+    uint32_t bits = ld32(p);
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static inline double ldf64(const uint8_t *p)
+{
+    uint64_t bits = ld64(p);
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+/** Values to decode: whole values in the payload, capped at max. */
+static size_t decode_count(sdi12_bintype_t type, size_t len, size_t max)
+{
+    size_t size = sdi12_bintype_size(type);
+    if (size == 0) return 0;
+    size_t n = len / size;
+    return n < max ? n : max;
+}
+
+/**
+ * Scalar loop for every wire type from index i to n, converting with a
+ * plain cast to T. Used by the float and double decoders.
+ */
+#define DECODE_CAST(T)                                                           \
+    switch (type) {                                                              \
+    case SDI12_BINTYPE_INT8:                                                     \
+        for (; i < n; i++) out[i] = (T)(int8_t)p[i];                             \
+        break;                                                                   \
+    case SDI12_BINTYPE_UINT8:                                                    \
+        for (; i < n; i++) out[i] = (T)p[i];                                     \
+        break;                                                                   \
+    case SDI12_BINTYPE_INT16:                                                    \
+        for (; i < n; i++) out[i] = (T)(int16_t)ld16(p + 2 * i);                 \
+        break;                                                                   \
+    case SDI12_BINTYPE_UINT16:                                                   \
+        for (; i < n; i++) out[i] = (T)ld16(p + 2 * i);                          \
+        break;                                                                   \
+    case SDI12_BINTYPE_INT32:                                                    \
+        for (; i < n; i++) out[i] = (T)(int32_t)ld32(p + 4 * i);                 \
+        break;                                                                   \
+    case SDI12_BINTYPE_UINT32:                                                   \
+        for (; i < n; i++) out[i] = (T)ld32(p + 4 * i);                          \
+        break;                                                                   \
+    case SDI12_BINTYPE_INT64:                                                    \
+        for (; i < n; i++) out[i] = (T)(int64_t)ld64(p + 8 * i);                 \
+        break;                                                                   \
+    case SDI12_BINTYPE_UINT64:                                                   \
+        for (; i < n; i++) out[i] = (T)ld64(p + 8 * i);                          \
+        break;                                                                   \
+    case SDI12_BINTYPE_FLOAT32:                                                  \
+        for (; i < n; i++) out[i] = (T)ldf32(p + 4 * i);                         \
+        break;                                                                   \
+    case SDI12_BINTYPE_FLOAT64:                                                  \
+        for (; i < n; i++) out[i] = (T)ldf64(p + 8 * i);                         \
+        break;                                                                   \
+    default:                                                                     \
+        break;                                                                   \
+    }
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Vector paths                                                             */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Decode a leading run to float with SIMD; returns the values done. */
+static size_t simd_float(sdi12_bintype_t type, const uint8_t *p, size_t n, float *out)
+{
+    size_t i = 0;
+#if defined(SDI12_BIN_SSE2)
+    if (type == SDI12_BINTYPE_INT16) {
+        for (; i + 8 <= n; i += 8) {
+            __m128i v  = _mm_loadu_si128((const __m128i *)(const void *)(p + 2 * i));
+            __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+            _mm_storeu_ps(out + i,     _mm_cvtepi32_ps(lo));
+            _mm_storeu_ps(out + i + 4, _mm_cvtepi32_ps(hi));
+        }
+    } else if (type == SDI12_BINTYPE_INT32) {
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(const void *)(p + 4 * i));
+            _mm_storeu_ps(out + i, _mm_cvtepi32_ps(v));
+        }
+    }
+#elif defined(SDI12_BIN_NEON)
+    if (type == SDI12_BINTYPE_INT16) {
+        for (; i + 8 <= n; i += 8) {
+            int16x8_t v = vreinterpretq_s16_u8(vld1q_u8(p + 2 * i));
+            vst1q_f32(out + i,     vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))));
+            vst1q_f32(out + i + 4, vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))));
+        }
+    } else if (type == SDI12_BINTYPE_INT32) {
+        for (; i + 4 <= n; i += 4) {
+            int32x4_t v = vreinterpretq_s32_u8(vld1q_u8(p + 4 * i));
+            vst1q_f32(out + i, vcvtq_f32_s32(v));
+        }
+    }
+#endif
+#if defined(SDI12_BIN_HOST_LE)
+    /* Wire and host layouts agree: the copy is the whole decode */
+    if (type == SDI12_BINTYPE_FLOAT32) {
+        memcpy(out, p, n * sizeof(float));
+        i = n;
+    }
+#else
+    (void)type; (void)p; (void)n; (void)out;
+#endif
+    return i;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Public API                                                               */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+size_t sdi12_bin_decode_float(sdi12_bintype_t type, const void *payload,
+                              size_t len, float *out, size_t max)
+{
+    if (!payload || !out) return 0;
+    const uint8_t *p = (const uint8_t *)payload;
+    size_t n = decode_count(type, len, max);
+
+    size_t i = simd_float(type, p, n, out);
+    DECODE_CAST(float)
+    return n;
+}
+
+size_t sdi12_bin_decode_double(sdi12_bintype_t type, const void *payload,
+                               size_t len, double *out, size_t max)
+{
+    if (!payload || !out) return 0;
+    const uint8_t *p = (const uint8_t *)payload;
+    size_t n = decode_count(type, len, max);
+
+    size_t i = 0;
+    DECODE_CAST(double)
+    return n;
+}
+
+/** Nearest int64, halves away from zero, saturating; NaN gives 0. */
+static int64_t round_i64(double x)
+{
+    if (x != x) return 0;
+    if (x >= 9223372036854775807.0)  return INT64_MAX;
+    if (x <= -9223372036854775808.0) return INT64_MIN;
+
+    /* Truncate, then fix up from the exact remainder (no libm) */
+    int64_t t = (int64_t)x;
+    double frac = x - (double)t;
+    if (frac >= 0.5)       t++;
+    else if (frac <= -0.5) t--;
+    return t;
+}
+
+size_t sdi12_bin_decode_int64(sdi12_bintype_t type, const void *payload,
+                              size_t len, int64_t *out, size_t max)
+{
+    if (!payload || !out) return 0;
+    const uint8_t *p = (const uint8_t *)payload;
+    size_t n = decode_count(type, len, max);
+
+    size_t i = 0;
+    switch (type) {
+    case SDI12_BINTYPE_UINT64:
+        for (; i < n; i++) {
+            uint64_t v = ld64(p + 8 * i);
+            out[i] = v > (uint64_t)INT64_MAX ? INT64_MAX : (int64_t)v;
+        }
+        break;
+    case SDI12_BINTYPE_FLOAT32:
+        for (; i < n; i++) out[i] = round_i64((double)ldf32(p + 4 * i));
+        break;
+    case SDI12_BINTYPE_FLOAT64:
+        for (; i < n; i++) out[i] = round_i64(ldf64(p + 8 * i));
+        break;
+    default:
+        DECODE_CAST(int64_t)
+        break;
+    }
+    return n;
+}
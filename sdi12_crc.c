@@ -20,9 +20,13 @@
  *       else:          CRC >>= 1
  */
 uint16_t sdi12_crc16(const void *data, size_t len)
+{
+    return sdi12_crc16_update(0x0000, data, len);
+}
+
+uint16_t sdi12_crc16_update(uint16_t crc, const void *data, size_t len)
 {
     const uint8_t *p = (const uint8_t *)data;
-    uint16_t crc = 0x0000;
 
     for (size_t i = 0; i < len; i++) {
         crc ^= (uint16_t)p[i];
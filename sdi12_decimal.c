@@ -0,0 +1,94 @@
+/**
+ * @file sdi12_decimal.c
+ * @brief Exact decimal values: scanning, formatting and float conversion.
+ *
+ * Pure C, no dependencies beyond stdint/stddef. Scanning and formatting use
+ * integer arithmetic only; float appears only in the two conversions.
+ */
+#include "sdi12.h"
+
+/**
+ * Powers of ten a float holds exactly (5^10 < 2^24), so a mantissa below
+ * 2^24 divided by one of them is a single correctly rounded operation.
+ */
+static const float pow10_f[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+size_t sdi12_decimal_scan(const char *s, size_t len, sdi12_decimal_t *out)
+{
+    if (len == 0 || (s[0] != '+' && s[0] != '-')) return 0;
+
+    uint32_t m = 0;
+    uint8_t d = 0;
+    bool dot = false, ended = false;
+
+    size_t i = 1;
+    for (; i < len && ((s[i] >= '0' && s[i] <= '9') || s[i] == '.'); i++) {
+        if (ended || i >= SDI12_VALUE_MAX_CHARS) continue;
+        if (s[i] == '.') {
+            ended = dot;
+            dot = true;
+        } else {
+            m = m * 10u + (uint32_t)(s[i] - '0');
+            if (dot) d++;
+        }
+    }
+
+    /* At most eight digits: m < 10^8 fits int32 either way round */
+    out->mantissa = s[0] == '-' ? -(int32_t)m : (int32_t)m;
+    out->decimals = d;
+    return i;
+}
+
+int sdi12_decimal_format(char *buf, size_t buflen, sdi12_decimal_t d)
+{
+    if (!buf || d.decimals > SDI12_DECIMAL_MAX_PLACES) return 0;
+
+    uint32_t mag = d.mantissa < 0 ? 0u - (uint32_t)d.mantissa : (uint32_t)d.mantissa;
+
+    /* Digits, least significant first, padded to one before the point */
+    char digits[10];
+    uint8_t nd = 0;
+    do {
+        digits[nd++] = (char)('0' + mag % 10u);
+        mag /= 10u;
+    } while (mag > 0);
+    uint8_t need = d.decimals ? (uint8_t)(d.decimals + 1) : 1;
+    while (nd < need) digits[nd++] = '0';
+
+    size_t total = 1u + nd + (d.decimals ? 1u : 0u);
+    if (total + 1 > buflen) return 0;
+
+    size_t pos = 0;
+    buf[pos++] = d.mantissa < 0 ? '-' : '+';
+    while (nd > 0) {
+        if (nd == d.decimals) buf[pos++] = '.';
+        buf[pos++] = digits[--nd];
+    }
+    buf[pos] = '\0';
+    return (int)pos;
+}
+
+float sdi12_decimal_to_float(sdi12_decimal_t d)
+{
+    uint32_t mag = d.mantissa < 0 ? 0u - (uint32_t)d.mantissa : (uint32_t)d.mantissa;
+    uint8_t k = d.decimals < 10 ? d.decimals : 10;
+    float v = k ? (float)mag / pow10_f[k] : (float)mag;
+    return d.mantissa < 0 ? -v : v;
+}
+
+sdi12_decimal_t sdi12_decimal_from_value(sdi12_value_t v)
+{
+    sdi12_decimal_t d = { 0, v.decimals };
+    if (d.decimals > SDI12_DECIMAL_MAX_PLACES) d.decimals = SDI12_DECIMAL_MAX_PLACES;
+
+    /* A float times an exact power of ten below 2^34 is exact in double */
+    double x = (double)v.value * (double)pow10_f[d.decimals];
+    if (x != x) return d;
+    x += x < 0.0 ? -0.5 : 0.5;
+    if (x >= 2147483647.0)       d.mantissa = INT32_MAX;
+    else if (x <= -2147483647.0) d.mantissa = -INT32_MAX;
+    else                         d.mantissa = (int32_t)x;
+    return d;
+}
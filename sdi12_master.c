@@ -7,8 +7,6 @@
  */
 #include "sdi12_master.h"
 #include <string.h>
-#include <stdlib.h>
-#include <ctype.h>
 #include <stdio.h>
 
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -24,6 +22,36 @@ static size_t trim_crlf(char *buf, size_t len)
     return len;
 }
 
+/** Record bus activity for break elision (needs the millis callback). */
+static void note_bus_activity(sdi12_master_ctx_t *ctx)
+{
+    if (ctx->cb.millis) ctx->last_bus_ms = ctx->cb.millis(ctx->cb.user_data);
+}
+
+/**
+ * Wake the bus unless it is known to be awake: a break is needed before
+ * the first command and once the line has been marking for
+ * SDI12_MARKING_TIMEOUT_MS. Without a millis callback the idle time is
+ * unknown, so every call breaks. Returns true if a break was sent.
+ */
+static bool wake_bus(sdi12_master_ctx_t *ctx, bool force)
+{
+    if (!force && ctx->cb.millis && ctx->bus_awake &&
+        ctx->cb.millis(ctx->cb.user_data) - ctx->last_bus_ms < SDI12_MARKING_TIMEOUT_MS) {
+        ctx->breaks_elided++;
+        return false;
+    }
+
+    ctx->cb.send_break(ctx->cb.user_data);
+
+    /* Post-break marking time: ≥ 8.33ms */
+    ctx->cb.delay(SDI12_MARKING_MS, ctx->cb.user_data);
+
+    ctx->bus_awake = true;
+    note_bus_activity(ctx);
+    return true;
+}
+
 /**
  * Build a command string in the context buffer and transmit it.
  * Also switches direction to TX before sending, then back to RX.
@@ -38,20 +66,72 @@ static sdi12_err_t send_command(sdi12_master_ctx_t *ctx, const char *cmd)
     ctx->cb.set_direction(SDI12_DIR_TX, ctx->cb.user_data);
     ctx->cb.send(ctx->cmd_buf, len, ctx->cb.user_data);
     ctx->cb.set_direction(SDI12_DIR_RX, ctx->cb.user_data);
+    note_bus_activity(ctx);
 
     return SDI12_OK;
 }
 
-/** Receive a response with timeout. */
-static sdi12_err_t recv_response(sdi12_master_ctx_t *ctx, uint32_t timeout_ms)
+/** Time to transmit `chars` characters at 1200 baud (8.33 ms each). */
+static uint32_t line_time_ms(size_t chars)
+{
+    return (uint32_t)((chars * 25u + 2u) / 3u);
+}
+
+/**
+ * Longest silence inside a reply before it is taken as ended. In line
+ * mode (char_gap_ms 0) the rest of the longest reply, `remaining`
+ * characters, may arrive as one late burst.
+ */
+static uint32_t rx_gap_ms(const sdi12_master_ctx_t *ctx, size_t remaining)
+{
+    if (ctx->char_gap_ms) return ctx->char_gap_ms;
+    return line_time_ms(remaining) + SDI12_RESPONSE_TIMEOUT_MS;
+}
+
+/**
+ * Receive one response frame. The first byte may take up to timeout_ms;
+ * after that bytes are read one at a time with a rx_gap_ms() timeout.
+ * The framer checks content and the expected length bounds only: it is
+ * fed synthetic timestamps one character time apart, so its own 1.66 ms
+ * gap check never fires here and a late or bunched delivery is not
+ * mistaken for a gap. A fixed-length reply completes on its last byte.
+ */
+static sdi12_err_t recv_response(sdi12_master_ctx_t *ctx, uint32_t timeout_ms,
+                                 sdi12_resp_len_t expect)
 {
-    ctx->resp_len = ctx->cb.recv(ctx->resp_buf, sizeof(ctx->resp_buf) - 1,
-                                  timeout_ms, ctx->cb.user_data);
-    if (ctx->resp_len == 0) {
-        return SDI12_ERR_TIMEOUT;
+    sdi12_framer_t f;
+    sdi12_framer_start(&f, ctx->resp_buf, sizeof(ctx->resp_buf), '\0', 0, 0);
+    sdi12_framer_expect(&f, expect);
+    ctx->resp_len = 0;
+
+    size_t longest = expect.max ? expect.max : SDI12_RESP_MAX_CHARS;
+    uint32_t t_us = 0;
+    while (f.status == SDI12_FRAME_PENDING) {
+        char c;
+        size_t left = longest > f.len ? longest - f.len : 0;
+        uint32_t wait_ms = f.len ? rx_gap_ms(ctx, left) : timeout_ms;
+        if (ctx->cb.recv(&c, 1, wait_ms, ctx->cb.user_data) == 0) {
+            if (f.len == 0) return SDI12_ERR_TIMEOUT;
+            f.status = SDI12_FRAME_TRUNCATED;
+            break;
+        }
+        if (f.len == 0 && ctx->cb.millis) {
+            ctx->rx_first_ms = ctx->cb.millis(ctx->cb.user_data);
+        }
+        t_us += SDI12_CHAR_US;
+        sdi12_framer_feed(&f, c, t_us);
     }
-    ctx->resp_buf[ctx->resp_len] = '\0';
-    return SDI12_OK;
+
+    ctx->resp_len = f.len;
+    note_bus_activity(ctx);
+    if (f.status == SDI12_FRAME_COMPLETE) return SDI12_OK;
+
+    /* Drain the rest of a bad frame so it cannot pollute the next reply */
+    if (f.status == SDI12_FRAME_GARBAGE) {
+        char c;
+        while (ctx->cb.recv(&c, 1, rx_gap_ms(ctx, 0), ctx->cb.user_data) > 0) { }
+    }
+    return SDI12_ERR_PARSE_FAILED;
 }
 
 /** Read exactly `count` bytes using the recv callback. */
@@ -65,6 +145,7 @@ static sdi12_err_t recv_exact(sdi12_master_ctx_t *ctx,
         if (n == 0) return SDI12_ERR_TIMEOUT;
         got += n;
     }
+    note_bus_activity(ctx);
     return SDI12_OK;
 }
 
@@ -80,6 +161,276 @@ static int parse_digits(const char *s, size_t max, uint32_t *out)
     return n;
 }
 
+/** Build aM!/aMC!/aMn!/aC!/aCC!/aV!/aHA!/aHB! into `cmd`. */
+static sdi12_err_t format_meas_cmd(char *cmd, size_t size, char addr,
+                                   sdi12_meas_type_t type, uint8_t group,
+                                   bool crc)
+{
+    switch (type) {
+    case SDI12_MEAS_STANDARD:
+        if (crc) {
+            if (group > 0) snprintf(cmd, size, "%cMC%u!", addr, group);
+            else           snprintf(cmd, size, "%cMC!", addr);
+        } else {
+            if (group > 0) snprintf(cmd, size, "%cM%u!", addr, group);
+            else           snprintf(cmd, size, "%cM!", addr);
+        }
+        break;
+
+    case SDI12_MEAS_CONCURRENT:
+        if (crc) {
+            if (group > 0) snprintf(cmd, size, "%cCC%u!", addr, group);
+            else           snprintf(cmd, size, "%cCC!", addr);
+        } else {
+            if (group > 0) snprintf(cmd, size, "%cC%u!", addr, group);
+            else           snprintf(cmd, size, "%cC!", addr);
+        }
+        break;
+
+    case SDI12_MEAS_VERIFICATION:
+        snprintf(cmd, size, "%cV!", addr);
+        break;
+
+    case SDI12_MEAS_HIGHVOL_ASCII:
+        if (crc) snprintf(cmd, size, "%cHAC!", addr);
+        else     snprintf(cmd, size, "%cHA!", addr);
+        break;
+
+    case SDI12_MEAS_HIGHVOL_BINARY:
+        if (crc) snprintf(cmd, size, "%cHBC!", addr);
+        else     snprintf(cmd, size, "%cHB!", addr);
+        break;
+
+    default:
+        return SDI12_ERR_INVALID_COMMAND;
+    }
+    return SDI12_OK;
+}
+
+/**
+ * Shared D/R page scanner. Each value goes to `dec` as an exact decimal,
+ * to `vals` converted to float, or to `spans` as its text; exactly one of
+ * the three is non-NULL.
+ * With `crc`, the CRC is carried over every character of the value
+ * region as the scan passes it, so checking it needs no second pass.
+ */
+static sdi12_err_t parse_values(const char *resp_str, size_t len,
+                                sdi12_value_t *vals, sdi12_decimal_t *dec,
+                                sdi12_span_t *spans, uint8_t max_values, uint8_t *count,
+                                bool verify_crc, uint16_t *crc)
+{
+    *count = 0;
+
+    /* The last 3 chars are the CRC; the address before resp_str is the
+     * caller's to fold in (see parse_line()) */
+    size_t data_len = len;
+    if (verify_crc && data_len >= 3) {
+        data_len -= 3;
+    }
+
+    /* Parse sign-prefixed values: +1.23-4.56+7.89 */
+    size_t pos = 0, mark = 0;
+    while (pos < data_len && *count < max_values) {
+        /* Skip whitespace */
+        while (pos < data_len && resp_str[pos] == ' ') pos++;
+        if (pos >= data_len) break;
+
+        /* Expect + or - */
+        sdi12_decimal_t d;
+        size_t used = sdi12_decimal_scan(resp_str + pos, data_len - pos, &d);
+        if (used == 0) {
+            pos++;
+            continue;
+        }
+        if (used > 1) {
+            if (dec) {
+                dec[*count] = d;
+            } else if (spans) {
+                spans[*count].ptr = resp_str + pos;
+                spans[*count].len = used;
+            } else {
+                /* "-0.0" keeps its sign, as strtof() would */
+                float v = sdi12_decimal_to_float(d);
+                vals[*count].value = resp_str[pos] == '-' && v == 0.0f ? -v : v;
+                vals[*count].decimals = d.decimals;
+            }
+            (*count)++;
+        }
+        pos += used;
+        if (crc) {
+            *crc = sdi12_crc16_update(*crc, resp_str + mark, pos - mark);
+            mark = pos;
+        }
+    }
+    if (crc && mark < data_len) {
+        *crc = sdi12_crc16_update(*crc, resp_str + mark, data_len - mark);
+    }
+
+    return SDI12_OK;
+}
+
+/**
+ * Parse a trimmed D/R line "a<values>[CRC]" from resp_buf. With `crc` the
+ * CRC over address + values is verified during the same scan; the values
+ * are still returned on a mismatch, for the caller to discard.
+ *
+ * @return SDI12_OK, or SDI12_ERR_CRC_MISMATCH.
+ */
+static sdi12_err_t parse_line(const char *line, size_t len,
+                              sdi12_value_t *vals, sdi12_decimal_t *dec,
+                              sdi12_span_t *spans, uint8_t max_values, uint8_t *count,
+                              bool crc, bool *crc_valid)
+{
+    bool ok = false;
+    if (!crc || len < 4) {
+        parse_values(line + 1, len - 1, vals, dec, spans, max_values, count, crc, NULL);
+    } else {
+        uint16_t acc = sdi12_crc16_update(0x0000, line, 1);
+        parse_values(line + 1, len - 1, vals, dec, spans, max_values, count, true, &acc);
+        char expect[4];
+        sdi12_crc_encode_ascii(acc, expect);
+        ok = memcmp(expect, line + len - 3, 3) == 0;
+    }
+
+    if (crc_valid) *crc_valid = ok;
+    return crc && !ok ? SDI12_ERR_CRC_MISMATCH : SDI12_OK;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Retry Engine                                                             */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Find or claim the link slot for `addr`; NULL if none is available. */
+static sdi12_link_t *link_for(sdi12_master_ctx_t *ctx, char addr)
+{
+    if (!ctx->links || !sdi12_valid_address(addr)) return NULL;
+
+    sdi12_link_t *free_slot = NULL;
+    for (size_t i = 0; i < ctx->link_count; i++) {
+        if (ctx->links[i].addr == addr) return &ctx->links[i];
+        if (!free_slot && ctx->links[i].addr == '\0') free_slot = &ctx->links[i];
+    }
+    if (free_slot) free_slot->addr = addr;
+    return free_slot;
+}
+
+/** Fold one attempt's outcome into the smoothed failure rate (1/8 weight). */
+static void link_note(sdi12_link_t *link, bool failed)
+{
+    int32_t sample = failed ? 1000 : 0;
+    int32_t rate = link->fail_permille;
+    link->fail_permille = (uint16_t)(rate + (sample - rate) / 8);
+}
+
+/** First-byte timeout for the link: its learned turnaround, or the caller's. */
+static uint32_t link_timeout(const sdi12_master_ctx_t *ctx,
+                             const sdi12_link_t *link, uint32_t timeout_ms)
+{
+    if (!ctx->cb.millis || link->ok < SDI12_LINK_LEARN ||
+        link->fail_permille >= SDI12_LINK_FLAKY_PERMILLE) {
+        return timeout_ms;
+    }
+    uint32_t learned = (uint32_t)link->latency_max_ms + rx_gap_ms(ctx, 0);
+    return learned < timeout_ms ? learned : timeout_ms;
+}
+
+/**
+ * One attempt: send, receive, and learn from the outcome. `idle_ms`
+ * accumulates the estimated line idle time for clockless re-breaks.
+ */
+static sdi12_err_t link_attempt(sdi12_master_ctx_t *ctx, sdi12_link_t *link,
+                                const char *cmd, uint32_t wait_ms,
+                                uint32_t *idle_ms)
+{
+    sdi12_err_t err = send_command(ctx, cmd);
+    if (err != SDI12_OK) return err;
+    uint32_t sent_ms = ctx->cb.millis ? ctx->cb.millis(ctx->cb.user_data) : 0;
+
+    err = recv_response(ctx, wait_ms, sdi12_master_response_len(cmd));
+    if (err == SDI12_OK) {
+        link->ok++;
+        link_note(link, false);
+        *idle_ms = 0;
+        if (ctx->cb.millis) {
+            /* Turnaround: recv returns after the first character */
+            uint32_t lat = ctx->rx_first_ms - sent_ms;
+            uint32_t char_ms = SDI12_CHAR_US / 1000u;
+            lat = lat > char_ms ? lat - char_ms : 0;
+            if (lat > UINT16_MAX) lat = UINT16_MAX;
+            int32_t avg = link->latency_ms;
+            link->latency_ms = (uint16_t)(avg + ((int32_t)lat - avg) / 8);
+            if (lat > link->latency_max_ms) link->latency_max_ms = (uint16_t)lat;
+        }
+        return SDI12_OK;
+    }
+
+    if (err == SDI12_ERR_TIMEOUT) {
+        link->timeouts++;
+        *idle_ms += wait_ms;
+    } else {
+        link->bad_frames++;
+    }
+    link_note(link, true);
+    return err;
+}
+
+/**
+ * Space a retry per the spec: at least SDI12_RETRY_MIN_MS after the
+ * previous command, and a fresh break if the sensors may have gone back
+ * to sleep (SDI12_MARKING_TIMEOUT_MS of idle line).
+ */
+static void link_pace_retry(sdi12_master_ctx_t *ctx, sdi12_link_t *link,
+                            uint32_t wait_ms, uint32_t *idle_ms)
+{
+    uint32_t since_cmd = wait_ms;
+    if (ctx->cb.millis) since_cmd = ctx->cb.millis(ctx->cb.user_data) - ctx->last_bus_ms;
+    if (since_cmd < SDI12_RETRY_MIN_MS) {
+        ctx->cb.delay(SDI12_RETRY_MIN_MS - since_cmd, ctx->cb.user_data);
+        *idle_ms += SDI12_RETRY_MIN_MS - since_cmd;
+    }
+
+    bool asleep = ctx->cb.millis
+        ? !ctx->bus_awake || ctx->cb.millis(ctx->cb.user_data) - ctx->last_bus_ms >=
+                             SDI12_MARKING_TIMEOUT_MS
+        : *idle_ms >= SDI12_MARKING_TIMEOUT_MS;
+    if (asleep) {
+        wake_bus(ctx, true);
+        link->rebreaks++;
+        *idle_ms = 0;
+    }
+}
+
+/** sdi12_master_transact() with retries and link learning. */
+static sdi12_err_t link_transact(sdi12_master_ctx_t *ctx, sdi12_link_t *link,
+                                 const char *cmd, uint32_t timeout_ms)
+{
+    link->transactions++;
+    uint8_t rounds = link->fail_permille >= SDI12_LINK_FLAKY_PERMILLE ? 2 : 1;
+    uint32_t wait_ms = link_timeout(ctx, link, timeout_ms);
+    uint32_t idle_ms = 0;
+    sdi12_err_t err = SDI12_ERR_TIMEOUT;
+
+    for (uint8_t round = 0; round < rounds; round++) {
+        for (uint8_t i = 0; i <= SDI12_LINK_RETRIES; i++) {
+            if (round > 0 || i > 0) {
+                link->retries++;
+                if (round > 0 && i == 0) {
+                    wake_bus(ctx, true);     /* second round starts fresh */
+                    link->rebreaks++;
+                    idle_ms = 0;
+                } else {
+                    link_pace_retry(ctx, link, wait_ms, &idle_ms);
+                }
+            }
+            err = link_attempt(ctx, link, cmd, wait_ms, &idle_ms);
+            if (err == SDI12_OK || err == SDI12_ERR_INVALID_COMMAND) return err;
+        }
+    }
+
+    link->failures++;
+    return err;
+}
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Public API — Initialization                                              */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -98,6 +449,11 @@ sdi12_err_t sdi12_master_init(sdi12_master_ctx_t *ctx,
     return SDI12_OK;
 }
 
+void sdi12_master_set_char_gap(sdi12_master_ctx_t *ctx, uint32_t gap_ms)
+{
+    if (ctx) ctx->char_gap_ms = gap_ms;
+}
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Bus Operations                                                           */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -106,21 +462,48 @@ sdi12_err_t sdi12_master_send_break(sdi12_master_ctx_t *ctx)
 {
     if (!ctx) return SDI12_ERR_CALLBACK_MISSING;
 
-    ctx->cb.send_break(ctx->cb.user_data);
+    wake_bus(ctx, false);
+    return SDI12_OK;
+}
 
-    /* Post-break marking time: ≥ 8.33ms */
-    ctx->cb.delay(SDI12_MARKING_MS, ctx->cb.user_data);
+sdi12_err_t sdi12_master_force_break(sdi12_master_ctx_t *ctx)
+{
+    if (!ctx) return SDI12_ERR_CALLBACK_MISSING;
 
+    wake_bus(ctx, true);
     return SDI12_OK;
 }
 
 sdi12_err_t sdi12_master_transact(sdi12_master_ctx_t *ctx,
                                    const char *cmd, uint32_t timeout_ms)
 {
+    sdi12_link_t *link = link_for(ctx, cmd[0]);
+    if (link) return link_transact(ctx, link, cmd, timeout_ms);
+
     sdi12_err_t err = send_command(ctx, cmd);
     if (err != SDI12_OK) return err;
 
-    return recv_response(ctx, timeout_ms);
+    return recv_response(ctx, timeout_ms, sdi12_master_response_len(cmd));
+}
+
+sdi12_err_t sdi12_master_set_links(sdi12_master_ctx_t *ctx,
+                                    sdi12_link_t *links, size_t count)
+{
+    if (!ctx) return SDI12_ERR_CALLBACK_MISSING;
+
+    if (links) memset(links, 0, count * sizeof(*links));
+    ctx->links = links;
+    ctx->link_count = links ? count : 0;
+    return SDI12_OK;
+}
+
+const sdi12_link_t *sdi12_master_link(const sdi12_master_ctx_t *ctx, char addr)
+{
+    if (!ctx || !ctx->links) return NULL;
+    for (size_t i = 0; i < ctx->link_count; i++) {
+        if (ctx->links[i].addr == addr) return &ctx->links[i];
+    }
+    return NULL;
 }
 
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -186,14 +569,66 @@ sdi12_err_t sdi12_master_change_address(sdi12_master_ctx_t *ctx,
     return SDI12_ERR_INVALID_ADDRESS;
 }
 
+/**
+ * One scan probe, bypassing the link retries: send and give the sensor
+ * exactly the response window. Once that has closed in silence, nothing
+ * can still answer and the next address may be probed at once.
+ */
+static sdi12_err_t scan_probe(sdi12_master_ctx_t *ctx, const char *cmd)
+{
+    sdi12_err_t err = send_command(ctx, cmd);
+    if (err != SDI12_OK) return err;
+
+    return recv_response(ctx, SDI12_RESPONSE_TIMEOUT_MS, sdi12_master_response_len(cmd));
+}
+
+sdi12_err_t sdi12_master_scan(sdi12_master_ctx_t *ctx, bool exhaustive,
+                               uint64_t *found)
+{
+    if (!ctx || !found) return SDI12_ERR_INVALID_COMMAND;
+    *found = 0;
+
+    wake_bus(ctx, false);
+
+    /* "?!" — silence proves the bus is empty */
+    sdi12_err_t err = scan_probe(ctx, "?!");
+    if (err == SDI12_ERR_TIMEOUT) return SDI12_OK;
+
+    char cmd[4];
+    if (err == SDI12_OK && !exhaustive && sdi12_valid_address(ctx->resp_buf[0])) {
+        char addr = ctx->resp_buf[0];
+        snprintf(cmd, sizeof(cmd), "%c!", addr);
+        if (scan_probe(ctx, cmd) == SDI12_OK && ctx->resp_buf[0] == addr) {
+            *found = (uint64_t)1 << sdi12_address_index(addr);
+            return SDI12_OK;
+        }
+    }
+
+    for (int i = 0; i < 62; i++) {
+        char addr = sdi12_address_from_index(i);
+        snprintf(cmd, sizeof(cmd), "%c!", addr);
+
+        for (uint8_t attempt = 0; attempt <= SDI12_LINK_RETRIES; attempt++) {
+            if (attempt > 0) ctx->cb.delay(SDI12_RETRY_MIN_MS, ctx->cb.user_data);
+            if (ctx->cb.millis) wake_bus(ctx, false);   /* no-op while busy */
+            err = scan_probe(ctx, cmd);
+            if (err != SDI12_ERR_PARSE_FAILED) break;  /* garbled: retry */
+        }
+        if (err == SDI12_OK && ctx->resp_buf[0] == addr) {
+            *found |= (uint64_t)1 << i;
+        }
+    }
+    return SDI12_OK;
+}
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Identification                                                           */
 /* ────────────────────────────────────────────────────────────────────────── */
 
-sdi12_err_t sdi12_master_identify(sdi12_master_ctx_t *ctx,
-                                   char addr, sdi12_ident_t *ident)
+sdi12_err_t sdi12_master_identify_view(sdi12_master_ctx_t *ctx,
+                                       char addr, sdi12_ident_view_t *view)
 {
-    if (!ctx || !ident) return SDI12_ERR_INVALID_COMMAND;
+    if (!ctx || !view) return SDI12_ERR_INVALID_COMMAND;
     if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
 
     char cmd[8];
@@ -214,36 +649,38 @@ sdi12_err_t sdi12_master_identify(sdi12_master_ctx_t *ctx,
      */
     if (len < 20) return SDI12_ERR_INVALID_COMMAND; /* Minimum: 1+2+8+6+3 = 20 */
 
-    memset(ident, 0, sizeof(*ident));
-
-    /* Skip address (1) and version (2) */
-    size_t pos = 3;
-
-    /* Vendor: 8 chars */
-    memcpy(ident->vendor, ctx->resp_buf + pos, 8);
-    ident->vendor[8] = '\0';
-    pos += 8;
+    const char *r = ctx->resp_buf;
+    view->address = r[0];
+    view->version.ptr  = r + 1;  view->version.len  = SDI12_ID_VERSION_LEN;
+    view->vendor.ptr   = r + 3;  view->vendor.len   = SDI12_ID_VENDOR_LEN;
+    view->model.ptr    = r + 11; view->model.len    = SDI12_ID_MODEL_LEN;
+    view->firmware.ptr = r + 17; view->firmware.len = SDI12_ID_FWVER_LEN;
+    view->serial.ptr   = r + 20; view->serial.len   = len - 20;
+    return SDI12_OK;
+}
 
-    /* Model: 6 chars */
-    memcpy(ident->model, ctx->resp_buf + pos, 6);
-    ident->model[6] = '\0';
-    pos += 6;
+/** Copy a view into a null-terminated field of `cap` bytes, truncating. */
+static void span_copy(char *dst, size_t cap, sdi12_span_t src)
+{
+    size_t n = src.len < cap - 1 ? src.len : cap - 1;
+    memcpy(dst, src.ptr, n);
+    dst[n] = '\0';
+}
 
-    /* Firmware version: 3 chars */
-    memcpy(ident->firmware_version, ctx->resp_buf + pos, 3);
-    ident->firmware_version[3] = '\0';
-    pos += 3;
+sdi12_err_t sdi12_master_identify(sdi12_master_ctx_t *ctx,
+                                   char addr, sdi12_ident_t *ident)
+{
+    if (!ctx || !ident) return SDI12_ERR_INVALID_COMMAND;
 
-    /* Serial: remaining chars (0-13) */
-    if (pos < len) {
-        size_t sn_len = len - pos;
-        if (sn_len > sizeof(ident->serial) - 1) {
-            sn_len = sizeof(ident->serial) - 1;
-        }
-        memcpy(ident->serial, ctx->resp_buf + pos, sn_len);
-        ident->serial[sn_len] = '\0';
-    }
+    sdi12_ident_view_t v;
+    sdi12_err_t err = sdi12_master_identify_view(ctx, addr, &v);
+    if (err != SDI12_OK) return err;
 
+    memset(ident, 0, sizeof(*ident));
+    span_copy(ident->vendor, sizeof(ident->vendor), v.vendor);
+    span_copy(ident->model, sizeof(ident->model), v.model);
+    span_copy(ident->firmware_version, sizeof(ident->firmware_version), v.firmware);
+    span_copy(ident->serial, sizeof(ident->serial), v.serial);
     return SDI12_OK;
 }
 
@@ -261,44 +698,8 @@ sdi12_err_t sdi12_master_start_measurement(sdi12_master_ctx_t *ctx,
     if (!ctx || !resp) return SDI12_ERR_INVALID_COMMAND;
     if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
 
-    /* Build command */
     char cmd[16];
-    switch (type) {
-    case SDI12_MEAS_STANDARD:
-        if (crc) {
-            if (group > 0) snprintf(cmd, sizeof(cmd), "%cMC%u!", addr, group);
-            else           snprintf(cmd, sizeof(cmd), "%cMC!", addr);
-        } else {
-            if (group > 0) snprintf(cmd, sizeof(cmd), "%cM%u!", addr, group);
-            else           snprintf(cmd, sizeof(cmd), "%cM!", addr);
-        }
-        break;
-
-    case SDI12_MEAS_CONCURRENT:
-        if (crc) {
-            if (group > 0) snprintf(cmd, sizeof(cmd), "%cCC%u!", addr, group);
-            else           snprintf(cmd, sizeof(cmd), "%cCC!", addr);
-        } else {
-            if (group > 0) snprintf(cmd, sizeof(cmd), "%cC%u!", addr, group);
-            else           snprintf(cmd, sizeof(cmd), "%cC!", addr);
-        }
-        break;
-
-    case SDI12_MEAS_VERIFICATION:
-        snprintf(cmd, sizeof(cmd), "%cV!", addr);
-        break;
-
-    case SDI12_MEAS_HIGHVOL_ASCII:
-        if (crc) snprintf(cmd, sizeof(cmd), "%cHAC!", addr);
-        else     snprintf(cmd, sizeof(cmd), "%cHA!", addr);
-        break;
-
-    case SDI12_MEAS_HIGHVOL_BINARY:
-        if (crc) snprintf(cmd, sizeof(cmd), "%cHBC!", addr);
-        else     snprintf(cmd, sizeof(cmd), "%cHB!", addr);
-        break;
-
-    default:
+    if (format_meas_cmd(cmd, sizeof(cmd), addr, type, group, crc) != SDI12_OK) {
         return SDI12_ERR_INVALID_COMMAND;
     }
 
@@ -315,7 +716,8 @@ sdi12_err_t sdi12_master_wait_service_request(sdi12_master_ctx_t *ctx,
 {
     if (!ctx) return SDI12_ERR_CALLBACK_MISSING;
 
-    sdi12_err_t err = recv_response(ctx, timeout_ms);
+    const sdi12_resp_len_t service_req = { 3, 3 };   /* a<CR><LF> */
+    sdi12_err_t err = recv_response(ctx, timeout_ms, service_req);
     if (err != SDI12_OK) return err;
 
     size_t len = trim_crlf(ctx->resp_buf, ctx->resp_len);
@@ -346,10 +748,52 @@ sdi12_err_t sdi12_master_get_data(sdi12_master_ctx_t *ctx,
 
     resp->address = ctx->resp_buf[0];
 
-    return sdi12_master_parse_data_values(
-        ctx->resp_buf + 1, len - 1,
-        resp->values, SDI12_MAX_VALUES,
-        &resp->value_count, crc);
+    return parse_line(ctx->resp_buf, len, resp->values, NULL, NULL, SDI12_MAX_VALUES,
+                      &resp->value_count, crc, &resp->crc_valid);
+}
+
+sdi12_err_t sdi12_master_get_data_decimal(sdi12_master_ctx_t *ctx,
+                                          char addr, uint8_t page, bool crc,
+                                          sdi12_decimal_t *values,
+                                          uint8_t max_values,
+                                          uint8_t *count)
+{
+    if (!ctx || !values || !count) return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+
+    char cmd[8];
+    snprintf(cmd, sizeof(cmd), "%cD%u!", addr, page);
+
+    sdi12_err_t err = sdi12_master_transact(ctx, cmd, SDI12_RESPONSE_TIMEOUT_MS);
+    if (err != SDI12_OK) return err;
+
+    size_t len = trim_crlf(ctx->resp_buf, ctx->resp_len);
+    if (len < 1) return SDI12_ERR_INVALID_COMMAND;
+
+    return parse_line(ctx->resp_buf, len, NULL, values, NULL, max_values, count,
+                      crc, NULL);
+}
+
+sdi12_err_t sdi12_master_get_data_view(sdi12_master_ctx_t *ctx,
+                                       char addr, uint8_t page, bool crc,
+                                       sdi12_span_t *values,
+                                       uint8_t max_values,
+                                       uint8_t *count)
+{
+    if (!ctx || !values || !count) return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+
+    char cmd[8];
+    snprintf(cmd, sizeof(cmd), "%cD%u!", addr, page);
+
+    sdi12_err_t err = sdi12_master_transact(ctx, cmd, SDI12_RESPONSE_TIMEOUT_MS);
+    if (err != SDI12_OK) return err;
+
+    size_t len = trim_crlf(ctx->resp_buf, ctx->resp_len);
+    if (len < 1) return SDI12_ERR_INVALID_COMMAND;
+
+    return parse_line(ctx->resp_buf, len, NULL, NULL, values, max_values, count,
+                      crc, NULL);
 }
 
 sdi12_err_t sdi12_master_continuous(sdi12_master_ctx_t *ctx,
@@ -371,10 +815,8 @@ sdi12_err_t sdi12_master_continuous(sdi12_master_ctx_t *ctx,
 
     resp->address = ctx->resp_buf[0];
 
-    return sdi12_master_parse_data_values(
-        ctx->resp_buf + 1, len - 1,
-        resp->values, SDI12_MAX_VALUES,
-        &resp->value_count, crc);
+    return parse_line(ctx->resp_buf, len, resp->values, NULL, NULL, SDI12_MAX_VALUES,
+                      &resp->value_count, crc, &resp->crc_valid);
 }
 
 sdi12_err_t sdi12_master_verify(sdi12_master_ctx_t *ctx,
@@ -479,76 +921,1443 @@ sdi12_err_t sdi12_master_extended(sdi12_master_ctx_t *ctx,
                                    uint32_t timeout_ms)
 {
     if (!ctx || !xcmd || !resp_buf || !resp_len) return SDI12_ERR_INVALID_COMMAND;
+
+    sdi12_span_t view;
+    sdi12_err_t err = sdi12_master_extended_view(ctx, addr, xcmd, &view, timeout_ms);
+    if (err != SDI12_OK) return err;
+
+    size_t len = view.len;
+    if (len > *resp_len) len = *resp_len;
+
+    memcpy(resp_buf, view.ptr, len);
+    *resp_len = len;
+
+    return SDI12_OK;
+}
+
+sdi12_err_t sdi12_master_extended_view(sdi12_master_ctx_t *ctx,
+                                       char addr,
+                                       const char *xcmd,
+                                       sdi12_span_t *resp,
+                                       uint32_t timeout_ms)
+{
+    if (!ctx || !xcmd || !resp) return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+
+    char cmd[SDI12_CMD_MAX_CHARS + 4];
+    snprintf(cmd, sizeof(cmd), "%cX%s!", addr, xcmd);
+
+    sdi12_err_t err = sdi12_master_transact(ctx, cmd, timeout_ms);
+    if (err != SDI12_OK) return err;
+
+    resp->ptr = ctx->resp_buf;
+    resp->len = ctx->resp_len;
+    return SDI12_OK;
+}
+
+sdi12_err_t sdi12_master_extended_multiline(sdi12_master_ctx_t *ctx,
+                                             char addr,
+                                             const char *xcmd,
+                                             char *resp_buf, size_t resp_bufsize,
+                                             size_t *resp_len,
+                                             uint8_t *line_count,
+                                             uint32_t timeout_ms)
+{
+    if (!ctx || !xcmd || !resp_buf || !resp_len) return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+
+    char cmd[SDI12_CMD_MAX_CHARS + 4];
+    snprintf(cmd, sizeof(cmd), "%cX%s!", addr, xcmd);
+
+    /* Send the command */
+    sdi12_err_t err = send_command(ctx, cmd);
+    if (err != SDI12_OK) return err;
+
+    /* Receive the first line */
+    err = recv_response(ctx, timeout_ms, sdi12_master_response_len(cmd));
+    if (err != SDI12_OK) return err;
+
+    /* Copy first line into output buffer */
+    size_t total = 0;
+    uint8_t lines = 0;
+
+    if (ctx->resp_len > 0) {
+        size_t copy = ctx->resp_len;
+        if (copy > resp_bufsize) copy = resp_bufsize;
+        memcpy(resp_buf, ctx->resp_buf, copy);
+        total = copy;
+        lines = 1;
+    }
+
+    /* Keep collecting lines as long as data arrives within the multi-line gap */
+    while (total < resp_bufsize) {
+        const sdi12_resp_len_t any = { 0, 0 };
+        if (recv_response(ctx, SDI12_MULTILINE_GAP_MS, any) != SDI12_OK)
+            break; /* no more lines — 150ms gap elapsed */
+
+        size_t copy = ctx->resp_len;
+        if (total + copy > resp_bufsize) copy = resp_bufsize - total;
+        memcpy(resp_buf + total, ctx->resp_buf, copy);
+        total += copy;
+        lines++;
+    }
+
+    *resp_len = total;
+    if (line_count) *line_count = lines;
+
+    return SDI12_OK;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Receive Framer                                                           */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+void sdi12_framer_start(sdi12_framer_t *f, char *buf, size_t cap,
+                        char addr, size_t expect_len, uint32_t now_us)
+{
+    if (!f) return;
+    f->buf = buf;
+    f->cap = cap;
+    f->len = 0;
+    f->expect_len = expect_len;
+    f->min_len = 0;
+    f->max_len = 0;
+    f->addr = addr;
+    f->start_us = now_us;
+    f->last_us = now_us;
+    f->status = (buf && cap >= 2) ? SDI12_FRAME_PENDING : SDI12_FRAME_GARBAGE;
+    if (buf && cap > 0) buf[0] = '\0';
+}
+
+sdi12_frame_status_t sdi12_framer_feed(sdi12_framer_t *f, char c, uint32_t t_us)
+{
+    if (!f) return SDI12_FRAME_GARBAGE;
+    if (f->status != SDI12_FRAME_PENDING) return f->status;
+
+    /* 0x7F included: CRC characters run from 0x40 to 0x7F */
+    bool printable = (unsigned char)c >= 0x20 && (unsigned char)c <= 0x7F;
+
+    if (f->len == 0) {
+        if (!printable) return f->status;   /* line-turnaround noise */
+        if (f->addr && c != f->addr) return f->status = SDI12_FRAME_GARBAGE;
+    } else {
+        if (t_us - f->last_us > SDI12_CHAR_US + SDI12_INTERCHAR_MAX_US) {
+            return f->status = SDI12_FRAME_TRUNCATED;
+        }
+        bool after_cr = f->buf[f->len - 1] == '\r';
+        if (c == '\n') {
+            /* terminator — accepted with or without the CR; a frame
+             * ending before its minimum length lost characters */
+            size_t body = after_cr ? f->len - 1 : f->len;
+            if (f->min_len && body + 2 < f->min_len) {
+                return f->status = SDI12_FRAME_TRUNCATED;
+            }
+        } else if (after_cr || (!printable && c != '\r')) {
+            return f->status = SDI12_FRAME_GARBAGE;
+        }
+    }
+
+    if (f->len + 1 >= f->cap ||
+        (f->expect_len && f->len >= f->expect_len) ||
+        (f->max_len && f->len >= f->max_len)) {
+        return f->status = SDI12_FRAME_GARBAGE;   /* longer than possible */
+    }
+    f->buf[f->len++] = c;
+    f->buf[f->len] = '\0';
+    f->last_us = t_us;
+
+    if (c == '\n' || f->len == f->expect_len) f->status = SDI12_FRAME_COMPLETE;
+    return f->status;
+}
+
+sdi12_frame_status_t sdi12_framer_poll(sdi12_framer_t *f, uint32_t now_us)
+{
+    if (!f) return SDI12_FRAME_GARBAGE;
+    if (f->status != SDI12_FRAME_PENDING) return f->status;
+
+    if (f->len == 0) {
+        if (now_us - f->start_us >
+            SDI12_RESPONSE_TIMEOUT_MS * 1000u + SDI12_CHAR_US) {
+            f->status = SDI12_FRAME_TIMEOUT;
+        }
+    } else if (now_us - f->last_us > SDI12_CHAR_US + SDI12_INTERCHAR_MAX_US) {
+        f->status = SDI12_FRAME_TRUNCATED;
+    }
+    return f->status;
+}
+
+void sdi12_framer_expect(sdi12_framer_t *f, sdi12_resp_len_t len)
+{
+    if (!f) return;
+    f->min_len = len.min;
+    f->max_len = len.max;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Response Length Model                                                    */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Length of the atttn / atttnn / atttnnn reply to a measurement command. */
+static uint8_t meas_reply_len(char kind)
+{
+    switch (kind) {
+    case 'C': case 'R': return 8;    /* atttnn + CR/LF */
+    case 'H':           return 9;    /* atttnnn + CR/LF */
+    default:            return 7;    /* atttn + CR/LF */
+    }
+}
+
+/** Longest D page after a measurement of `type`. */
+static uint8_t data_page_len(sdi12_meas_type_t type, bool crc)
+{
+    size_t values = (type == SDI12_MEAS_STANDARD || type == SDI12_MEAS_VERIFICATION)
+                    ? SDI12_M_VALUES_MAX_CHARS : SDI12_C_VALUES_MAX_CHARS;
+    return (uint8_t)(1 + values + (crc ? 3 : 0) + 2);
+}
+
+sdi12_resp_len_t sdi12_master_response_len(const char *cmd)
+{
+    sdi12_resp_len_t r = { 0, 0 };
+    if (!cmd || !cmd[0]) return r;
+
+    const char *body = cmd + 1;
+    uint8_t page_max = (uint8_t)(1 + SDI12_C_VALUES_MAX_CHARS + 3 + 2);
+    r.min = 3;
+
+    switch (body[0]) {
+    case '!':                                 /* a! / ?! */
+    case 'A':                                 /* aAb! */
+        r.max = 3;
+        break;
+    case 'M': case 'V': case 'C':
+        r.min = r.max = meas_reply_len(body[0]);
+        break;
+    case 'H':
+        if (body[1] == 'A' || body[1] == 'B') r.min = r.max = meas_reply_len('H');
+        else                                  r.max = SDI12_RESP_MAX_CHARS;
+        break;
+    case 'I':
+        if (body[1] == '!') {                 /* a + 2 + 8 + 6 + 3 [+ 13] */
+            r.min = 1 + SDI12_ID_VERSION_LEN + SDI12_ID_VENDOR_LEN +
+                    SDI12_ID_MODEL_LEN + SDI12_ID_FWVER_LEN + 2;
+            r.max = (uint8_t)(r.min + SDI12_ID_SERIAL_MAXLEN);
+        } else if (strchr(body, '_')) {       /* aIM_001! parameter metadata */
+            r.max = SDI12_RESP_MAX_CHARS;
+        } else {                              /* aIM! aIC! aIHA! … */
+            r.max = meas_reply_len(body[1]);
+        }
+        break;
+    case 'D':
+    case 'R':
+        r.max = page_max;
+        break;
+    default:                                  /* aX..! and anything else */
+        r.max = SDI12_RESP_MAX_CHARS;
+        break;
+    }
+    return r;
+}
+
+uint32_t sdi12_master_response_deadline_ms(const char *cmd)
+{
+    if (!cmd) return 0;
+    return line_time_ms(strlen(cmd)) + SDI12_RESPONSE_TIMEOUT_MS +
+           line_time_ms(sdi12_master_response_len(cmd).max);
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Non-blocking Engine                                                      */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Transaction engine states (sdi12_txn_t.state). */
+enum {
+    TXN_QUEUED = 0,  /**< Waiting to reach the head of the queue. */
+    TXN_SEND,        /**< cmd_buf ready — send (after a break if needed). */
+    TXN_MARKING,     /**< Break sent; waiting out the marking time. */
+    TXN_WAIT_ACK,    /**< Waiting for the command's reply line. */
+    TXN_MEASURING,   /**< Waiting ttt or the service request. */
+    TXN_WAIT_DATA,   /**< Waiting for a D page. */
+    TXN_COMPLETE     /**< Result set; on_done pending. */
+};
+
+/** True once `deadline` has been reached (wrap-safe). */
+static bool deadline_due(uint32_t now, uint32_t deadline)
+{
+    return (int32_t)(now - deadline) >= 0;
+}
+
+static void txn_complete(sdi12_txn_t *txn, sdi12_err_t result)
+{
+    txn->result = result;
+    txn->state = TXN_COMPLETE;
+}
+
+/** Queue `aDn!` for the transaction's current page. */
+static void txn_request_page(sdi12_master_ctx_t *ctx, sdi12_txn_t *txn)
+{
+    snprintf(ctx->cmd_buf, sizeof(ctx->cmd_buf), "%cD%u!", txn->addr, txn->page);
+    txn->max_len = data_page_len(txn->type, txn->crc);
+    txn->next_state = TXN_WAIT_DATA;
+    txn->state = TXN_SEND;
+}
+
+/**
+ * Transmit cmd_buf and arm the first-byte deadline: the command's own
+ * line time (send may return before it is on the wire), the response
+ * timeout and one character. The rest of the reply's time is added when
+ * its first byte arrives, so an absent sensor costs no more than that.
+ */
+static void txn_transmit(sdi12_master_ctx_t *ctx, sdi12_txn_t *txn)
+{
+    size_t cmd_len = strlen(ctx->cmd_buf);
+    send_command(ctx, ctx->cmd_buf);
+    ctx->last_bus_ms = ctx->now_ms;
+    ctx->bus_awake = true;
+    ctx->resp_len = 0;
+
+    txn->deadline_ms = ctx->now_ms + line_time_ms(cmd_len) +
+                       SDI12_RESPONSE_TIMEOUT_MS + line_time_ms(1);
+    txn->state = txn->next_state;
+}
+
+/** Handle one complete response line for the head transaction. */
+static void txn_on_line(sdi12_master_ctx_t *ctx, sdi12_txn_t *txn)
+{
+    size_t len = trim_crlf(ctx->resp_buf, ctx->resp_len);
+
+    switch (txn->state) {
+    case TXN_WAIT_ACK:
+        if (txn->kind == SDI12_TXN_COMMAND) {
+            memcpy(txn->resp, ctx->resp_buf, len + 1);
+            txn->resp_len = len;
+            txn_complete(txn, SDI12_OK);
+            break;
+        }
+        if (len < 1 || ctx->resp_buf[0] != txn->addr) break;   /* not ours */
+        {
+            sdi12_err_t err = sdi12_master_parse_meas_response(
+                ctx->resp_buf, len, txn->type, &txn->meas);
+            if (err != SDI12_OK) {
+                txn_complete(txn, err);
+            } else if (txn->meas.value_count == 0) {
+                txn_complete(txn, SDI12_OK);
+            } else if (txn->meas.wait_seconds == 0) {
+                txn_request_page(ctx, txn);
+            } else {
+                txn->state = TXN_MEASURING;
+                txn->deadline_ms = ctx->now_ms + (uint32_t)txn->meas.wait_seconds * 1000u;
+            }
+        }
+        break;
+
+    case TXN_MEASURING:
+        /* Service request "a<CR><LF>" — data is ready early */
+        if (len == 1 && ctx->resp_buf[0] == txn->addr) {
+            txn_request_page(ctx, txn);
+        }
+        break;
+
+    case TXN_WAIT_DATA: {
+        if (len < 1 || ctx->resp_buf[0] != txn->addr) break;
+
+        uint8_t got = 0;
+        uint8_t room = (uint8_t)(SDI12_MAX_VALUES - txn->data.value_count);
+        if (parse_line(ctx->resp_buf, len,
+                       txn->data.values + txn->data.value_count, NULL, NULL,
+                       room, &got, txn->crc, &txn->data.crc_valid) != SDI12_OK) {
+            txn_complete(txn, SDI12_ERR_CRC_MISMATCH);
+            break;
+        }
+        txn->data.value_count = (uint8_t)(txn->data.value_count + got);
+
+        if (txn->data.value_count >= txn->meas.value_count) {
+            txn_complete(txn, SDI12_OK);
+        } else if (got == 0 || txn->page + 1 >= SDI12_MAX_DATA_PAGES) {
+            txn_complete(txn, SDI12_ERR_NO_DATA);   /* sensor ran short */
+        } else {
+            txn->page++;
+            txn_request_page(ctx, txn);
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+sdi12_err_t sdi12_master_submit(sdi12_master_ctx_t *ctx, sdi12_txn_t *txn)
+{
+    if (!ctx || !txn) return SDI12_ERR_INVALID_COMMAND;
+
+    if (txn->kind == SDI12_TXN_MEASURE) {
+        if (!sdi12_valid_address(txn->addr)) return SDI12_ERR_INVALID_ADDRESS;
+        if (txn->type != SDI12_MEAS_STANDARD &&
+            txn->type != SDI12_MEAS_CONCURRENT &&
+            txn->type != SDI12_MEAS_VERIFICATION) {
+            return SDI12_ERR_INVALID_COMMAND;
+        }
+    } else if (txn->kind == SDI12_TXN_COMMAND) {
+        const char *nul = (const char *)memchr(txn->cmd, '\0', sizeof(txn->cmd));
+        if (!nul || nul == txn->cmd) return SDI12_ERR_INVALID_COMMAND;
+        txn->addr = txn->cmd[0];
+    } else {
+        return SDI12_ERR_INVALID_COMMAND;
+    }
+
+    txn->result = SDI12_OK;
+    memset(&txn->meas, 0, sizeof(txn->meas));
+    memset(&txn->data, 0, sizeof(txn->data));
+    txn->data.address = txn->addr;
+    txn->resp_len = 0;
+    txn->state = TXN_QUEUED;
+    txn->page = 0;
+    txn->next = NULL;
+
+    if (ctx->txn_tail) ctx->txn_tail->next = txn;
+    else               ctx->txn_head = txn;
+    ctx->txn_tail = txn;
+    return SDI12_OK;
+}
+
+/**
+ * Hand the bytes queued by sdi12_master_on_rx() to the head transaction,
+ * a line at a time. Runs from poll(), so the engine state has one writer.
+ */
+static void txn_rx_drain(sdi12_master_ctx_t *ctx)
+{
+    uint8_t head = ctx->rx_head;
+    uint8_t tail = ctx->rx_tail;
+    if (head == tail && !ctx->rx_overrun) return;
+
+    /* Read until stable: a 32-bit store from on_rx() may not be atomic */
+    uint32_t t;
+    do { t = ctx->rx_last_ms; } while (t != ctx->rx_last_ms);
+    if (head != tail && (int32_t)(t - ctx->last_bus_ms) > 0) ctx->last_bus_ms = t;
+
+    for (; tail != head; tail++) {
+        char c = ctx->rx_ring[tail & (SDI12_RX_RING_SIZE - 1)];
+        sdi12_txn_t *txn = ctx->txn_head;
+        if (!txn || (txn->state != TXN_WAIT_ACK && txn->state != TXN_MEASURING &&
+                     txn->state != TXN_WAIT_DATA)) {
+            ctx->resp_len = 0;
+            continue;   /* nothing expects bytes — drop */
+        }
+
+        bool replying = txn->state != TXN_MEASURING;
+        if (replying && ctx->resp_len >= txn->max_len) {
+            txn_complete(txn, SDI12_ERR_PARSE_FAILED);   /* longer than possible */
+            ctx->resp_len = 0;
+            continue;
+        }
+        if (replying && ctx->resp_len == 0) {
+            /* First byte: the reply ends within max_len characters */
+            txn->deadline_ms += line_time_ms((size_t)txn->max_len - 1);
+        }
+
+        if (ctx->resp_len < sizeof(ctx->resp_buf) - 1) {
+            ctx->resp_buf[ctx->resp_len++] = c;
+        }
+
+        if (c == '\n') {
+            ctx->resp_buf[ctx->resp_len] = '\0';
+            txn_on_line(ctx, txn);
+            ctx->resp_len = 0;
+        }
+    }
+    ctx->rx_tail = tail;
+
+    if (ctx->rx_overrun) {
+        /* Part of a reply is gone: fail it rather than parse the rest */
+        ctx->rx_overrun = false;
+        ctx->resp_len = 0;
+        sdi12_txn_t *txn = ctx->txn_head;
+        if (txn && (txn->state == TXN_WAIT_ACK || txn->state == TXN_WAIT_DATA)) {
+            txn_complete(txn, SDI12_ERR_BUFFER_OVERFLOW);
+        }
+    }
+}
+
+uint32_t sdi12_master_poll(sdi12_master_ctx_t *ctx, uint32_t now_ms)
+{
+    if (!ctx) return SDI12_POLL_IDLE;
+    ctx->now_ms = now_ms;
+    txn_rx_drain(ctx);
+
+    for (;;) {
+        sdi12_txn_t *txn = ctx->txn_head;
+        if (!txn) return SDI12_POLL_IDLE;
+
+        switch (txn->state) {
+        case TXN_QUEUED:
+            if (txn->kind == SDI12_TXN_COMMAND) {
+                memcpy(ctx->cmd_buf, txn->cmd, strlen(txn->cmd) + 1);
+            } else {
+                format_meas_cmd(ctx->cmd_buf, sizeof(ctx->cmd_buf), txn->addr,
+                                txn->type, txn->group, txn->crc);
+            }
+            txn->max_len = sdi12_master_response_len(ctx->cmd_buf).max;
+            txn->next_state = TXN_WAIT_ACK;
+            txn->state = TXN_SEND;
+            continue;
+
+        case TXN_SEND:
+            if (!ctx->bus_awake ||
+                (uint32_t)(now_ms - ctx->last_bus_ms) >= SDI12_MARKING_TIMEOUT_MS) {
+                ctx->cb.send_break(ctx->cb.user_data);
+                txn->deadline_ms = now_ms + SDI12_MARKING_MS;
+                txn->state = TXN_MARKING;
+                return SDI12_MARKING_MS;
+            }
+            txn_transmit(ctx, txn);
+            continue;
+
+        case TXN_MARKING:
+            if (!deadline_due(now_ms, txn->deadline_ms)) break;
+            txn_transmit(ctx, txn);
+            continue;
+
+        case TXN_WAIT_ACK:
+        case TXN_WAIT_DATA:
+            if (!deadline_due(now_ms, txn->deadline_ms)) break;
+            txn_complete(txn, SDI12_ERR_TIMEOUT);
+            continue;
+
+        case TXN_MEASURING:
+            if (!deadline_due(now_ms, txn->deadline_ms)) break;
+            txn_request_page(ctx, txn);
+            continue;
+
+        case TXN_COMPLETE:
+        default:
+            ctx->txn_head = txn->next;
+            if (!ctx->txn_head) ctx->txn_tail = NULL;
+            txn->next = NULL;
+            if (txn->on_done) txn->on_done(txn, txn->user_data);
+            continue;
+        }
+
+        return txn->deadline_ms - now_ms;
+    }
+}
+
+void sdi12_master_on_rx(sdi12_master_ctx_t *ctx, const char *data, size_t len,
+                        uint32_t now_ms)
+{
+    if (!ctx || !data) return;
+
+    uint8_t head = ctx->rx_head;
+    for (size_t i = 0; i < len; i++) {
+        if ((uint8_t)(head - ctx->rx_tail) >= SDI12_RX_RING_SIZE) {
+            ctx->rx_overrun = true;
+            break;
+        }
+        ctx->rx_ring[head & (SDI12_RX_RING_SIZE - 1)] = data[i];
+        head++;
+    }
+    ctx->rx_last_ms = now_ms;
+    ctx->rx_head = head;   /* publish last */
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Timed Bus Helpers                                                        */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Elapsed-time and line-time bookkeeping for multi-command operations
+ * (survey, scheduler). Times are relative to start_ms.
+ */
+typedef struct {
+    uint32_t start_ms;  /**< millis() at the start (clock mode). */
+    uint32_t est_ms;    /**< Estimated elapsed time (no clock). */
+    uint32_t bus_ms;    /**< Line time used so far. */
+    uint32_t last_bus;  /**< Elapsed time at the end of the last bus activity. */
+    bool     awake;     /**< A break has been sent. */
+} bus_clock_t;
+
+/** Milliseconds since clk->start_ms. */
+static uint32_t clock_now(const sdi12_master_ctx_t *ctx, const bus_clock_t *clk)
+{
+    if (ctx->cb.millis) return ctx->cb.millis(ctx->cb.user_data) - clk->start_ms;
+    return clk->est_ms;
+}
+
+/** Send a break if the sensors may have gone back to sleep; true if sent. */
+static bool clock_wake(sdi12_master_ctx_t *ctx, bus_clock_t *clk)
+{
+    if (ctx->cb.millis) {
+        /* Real clock: the context's own tracking decides */
+        if (!wake_bus(ctx, false)) return false;
+    } else {
+        if (clk->awake &&
+            clock_now(ctx, clk) - clk->last_bus < SDI12_MARKING_TIMEOUT_MS) {
+            return false;
+        }
+        wake_bus(ctx, true);
+    }
+    clk->est_ms += SDI12_BREAK_MS + SDI12_MARKING_MS;
+    clk->bus_ms += SDI12_BREAK_MS + SDI12_MARKING_MS;
+    clk->awake = true;
+    return true;
+}
+
+/** Transact with break-when-needed and line-time accounting. */
+static sdi12_err_t clock_transact(sdi12_master_ctx_t *ctx,
+                                  bus_clock_t *clk, const char *cmd)
+{
+    clock_wake(ctx, clk);
+
+    sdi12_err_t err = sdi12_master_transact(ctx, cmd, SDI12_RESPONSE_TIMEOUT_MS);
+    size_t chars = strlen(cmd) + (err == SDI12_OK ? ctx->resp_len : 0);
+    clk->bus_ms += line_time_ms(chars);
+    clk->est_ms += line_time_ms(chars);
+    if (err == SDI12_ERR_TIMEOUT) clk->est_ms += SDI12_RESPONSE_TIMEOUT_MS;
+
+    clk->last_bus = clock_now(ctx, clk);
+    return err;
+}
+
+/** Start a measurement through clock_transact() and parse the reply. */
+static sdi12_err_t clock_start(sdi12_master_ctx_t *ctx, bus_clock_t *clk,
+                               char addr, sdi12_meas_type_t type,
+                               uint8_t group, bool crc,
+                               sdi12_meas_response_t *meas)
+{
+    memset(meas, 0, sizeof(*meas));
+
+    char cmd[16];
+    format_meas_cmd(cmd, sizeof(cmd), addr, type, group, crc);
+    sdi12_err_t err = clock_transact(ctx, clk, cmd);
+    if (err != SDI12_OK) return err;
+
+    size_t len = trim_crlf(ctx->resp_buf, ctx->resp_len);
+    return sdi12_master_parse_meas_response(ctx->resp_buf, len, type, meas);
+}
+
+/** Send aD<page>! and leave the trimmed reply, checked for `addr`, in resp_buf. */
+static sdi12_err_t fetch_page(sdi12_master_ctx_t *ctx, bus_clock_t *clk,
+                              char addr, uint16_t page, size_t *len)
+{
+    char cmd[12];
+    snprintf(cmd, sizeof(cmd), "%cD%u!", addr, page);
+
+    sdi12_err_t err = clock_transact(ctx, clk, cmd);
+    if (err != SDI12_OK) return err;
+
+    *len = trim_crlf(ctx->resp_buf, ctx->resp_len);
+    if (*len < 1 || ctx->resp_buf[0] != addr) return SDI12_ERR_PARSE_FAILED;
+    return SDI12_OK;
+}
+
+/** Fetch D pages until `expected` values have arrived. */
+static sdi12_err_t collect_pages(sdi12_master_ctx_t *ctx, bus_clock_t *clk,
+                                 char addr, bool crc, uint16_t expected,
+                                 sdi12_data_response_t *d)
+{
+    memset(d, 0, sizeof(*d));
+    d->address = addr;
+
+    for (uint8_t page = 0;
+         page < SDI12_MAX_DATA_PAGES && d->value_count < expected;
+         page++) {
+        size_t len;
+        sdi12_err_t err = fetch_page(ctx, clk, addr, page, &len);
+        if (err != SDI12_OK) return err;
+
+        uint8_t got = 0;
+        err = parse_line(ctx->resp_buf, len, d->values + d->value_count, NULL, NULL,
+                         (uint8_t)(SDI12_MAX_VALUES - d->value_count),
+                         &got, crc, &d->crc_valid);
+        if (err != SDI12_OK) return err;
+        if (got == 0) return SDI12_ERR_NO_DATA;   /* sensor ran short */
+        d->value_count = (uint8_t)(d->value_count + got);
+    }
+
+    return d->value_count >= expected ? SDI12_OK : SDI12_ERR_NO_DATA;
+}
+
+sdi12_err_t sdi12_master_collect(sdi12_master_ctx_t *ctx,
+                                  char addr,
+                                  const sdi12_meas_response_t *meas,
+                                  bool crc,
+                                  sdi12_data_response_t *out)
+{
+    if (!ctx || !meas || !out) return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+    if (meas->value_count > SDI12_MAX_VALUES) return SDI12_ERR_BUFFER_OVERFLOW;
+
+    /* The caller has just woken the bus (or waited for the service request) */
+    bus_clock_t clk;
+    memset(&clk, 0, sizeof(clk));
+    clk.awake = true;
+    if (ctx->cb.millis) clk.start_ms = ctx->cb.millis(ctx->cb.user_data);
+
+    return collect_pages(ctx, &clk, addr, crc, meas->value_count, out);
+}
+
+sdi12_err_t sdi12_master_collect_text(sdi12_master_ctx_t *ctx,
+                                       char addr,
+                                       const sdi12_meas_response_t *meas,
+                                       bool crc,
+                                       sdi12_value_emit_fn emit,
+                                       void *user_data,
+                                       uint16_t *emitted)
+{
+    if (!ctx || !meas || !emit) return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+
+    bus_clock_t clk;
+    memset(&clk, 0, sizeof(clk));
+    clk.awake = true;
+    if (ctx->cb.millis) clk.start_ms = ctx->cb.millis(ctx->cb.user_data);
+
+    /* Shortest value is "+0", so this bounds the values on one page */
+    enum { PAGE_VALUES = SDI12_C_VALUES_MAX_CHARS / 2 };
+    sdi12_span_t spans[PAGE_VALUES];
+    uint16_t n = 0;
+    sdi12_err_t err = SDI12_OK;
+
+    for (uint16_t page = 0;
+         page < SDI12_MAX_DATA_PAGES && n < meas->value_count;
+         page++) {
+        size_t len;
+        err = fetch_page(ctx, &clk, addr, page, &len);
+        if (err != SDI12_OK) break;
+
+        uint8_t got = 0;
+        err = parse_line(ctx->resp_buf, len, NULL, NULL, spans, PAGE_VALUES,
+                         &got, crc, NULL);
+        if (err != SDI12_OK) break;
+        if (got == 0) { err = SDI12_ERR_NO_DATA; break; }   /* sensor ran short */
+
+        for (uint8_t i = 0; i < got; i++) {
+            sdi12_decimal_t d;
+            sdi12_value_text_t v;
+            v.text = spans[i];
+            sdi12_decimal_scan(spans[i].ptr, spans[i].len, &d);   /* integer only */
+            v.decimals = d.decimals;
+            v.index = n++;
+            emit(addr, &v, user_data);
+        }
+    }
+
+    if (emitted) *emitted = n;
+    if (err != SDI12_OK) return err;
+    return n >= meas->value_count ? SDI12_OK : SDI12_ERR_NO_DATA;
+}
+
+void sdi12_data_soa_init(sdi12_data_soa_t *d, float *values, uint8_t *decimals,
+                         uint8_t *quality, uint16_t capacity)
+{
+    if (!d) return;
+    d->values = values;
+    d->decimals = decimals;
+    d->quality = quality;
+    d->capacity = values ? capacity : 0;
+    d->count = 0;
+    if (quality) memset(quality, 0, SDI12_SOA_QUALITY_BYTES(d->capacity));
+}
+
+sdi12_err_t sdi12_master_collect_soa(sdi12_master_ctx_t *ctx,
+                                      char addr,
+                                      const sdi12_meas_response_t *meas,
+                                      bool crc,
+                                      sdi12_data_soa_t *d)
+{
+    if (!ctx || !meas || !d || !d->values) return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+    if (d->count > d->capacity ||
+        meas->value_count > d->capacity - d->count) return SDI12_ERR_BUFFER_OVERFLOW;
+
+    bus_clock_t clk;
+    memset(&clk, 0, sizeof(clk));
+    clk.awake = true;
+    if (ctx->cb.millis) clk.start_ms = ctx->cb.millis(ctx->cb.user_data);
+
+    /* One page at a time, then scattered into the columns */
+    enum { PAGE_VALUES = SDI12_C_VALUES_MAX_CHARS / 2 };
+    sdi12_value_t page_vals[PAGE_VALUES];
+    uint16_t want = (uint16_t)(d->count + meas->value_count);
+
+    for (uint16_t page = 0; page < SDI12_MAX_DATA_PAGES && d->count < want; page++) {
+        size_t len;
+        sdi12_err_t err = fetch_page(ctx, &clk, addr, page, &len);
+        if (err != SDI12_OK) return err;
+
+        uint8_t got = 0;
+        err = parse_line(ctx->resp_buf, len, page_vals, NULL, NULL, PAGE_VALUES,
+                         &got, crc, NULL);
+        if (err != SDI12_OK) return err;
+        if (got == 0) return SDI12_ERR_NO_DATA;   /* sensor ran short */
+
+        for (uint8_t i = 0; i < got && d->count < d->capacity; i++) {
+            uint16_t k = d->count++;
+            d->values[k] = page_vals[i].value;
+            if (d->decimals) d->decimals[k] = page_vals[i].decimals;
+            if (d->quality) {
+                uint8_t bit = (uint8_t)(1u << (k % 8u));
+                if (crc) d->quality[k / 8u] |= bit;
+                else     d->quality[k / 8u] &= (uint8_t)~bit;
+            }
+        }
+    }
+
+    return d->count >= want ? SDI12_OK : SDI12_ERR_NO_DATA;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Survey                                                                   */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+sdi12_err_t sdi12_master_survey(sdi12_master_ctx_t *ctx,
+                                 sdi12_survey_entry_t *entries,
+                                 uint8_t count,
+                                 sdi12_survey_stats_t *stats)
+{
+    if (!ctx || (!entries && count > 0)) return SDI12_ERR_INVALID_COMMAND;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!sdi12_valid_address(entries[i].addr)) return SDI12_ERR_INVALID_ADDRESS;
+    }
+
+    bus_clock_t sc;
+    memset(&sc, 0, sizeof(sc));
+    if (ctx->cb.millis) sc.start_ms = ctx->cb.millis(ctx->cb.user_data);
+
+    uint32_t ttt_ms = 0;
+
+    /* Phase 1: start every sensor measuring */
+    for (uint8_t i = 0; i < count; i++) {
+        sdi12_survey_entry_t *e = &entries[i];
+        memset(&e->data, 0, sizeof(e->data));
+        e->data.address = e->addr;
+        e->done_ms = 0;
+
+        e->result = clock_start(ctx, &sc, e->addr, SDI12_MEAS_CONCURRENT,
+                                e->group, e->crc, &e->meas);
+        e->ready_ms = clock_now(ctx, &sc) + (uint32_t)e->meas.wait_seconds * 1000u;
+        ttt_ms += (uint32_t)e->meas.wait_seconds * 1000u;
+
+        /* Nothing to collect: done already (or failed) */
+        if (e->result != SDI12_OK || e->meas.value_count == 0) {
+            e->done_ms = clock_now(ctx, &sc);
+        }
+    }
+
+    /* Phase 2: collect in deadline order while the rest keep measuring */
+    for (;;) {
+        sdi12_survey_entry_t *next = NULL;
+        for (uint8_t i = 0; i < count; i++) {
+            sdi12_survey_entry_t *e = &entries[i];
+            if (e->result != SDI12_OK || e->meas.value_count == 0 ||
+                e->data.value_count > 0) {
+                continue;   /* failed, empty or already collected */
+            }
+            if (!next || (int32_t)(e->ready_ms - next->ready_ms) < 0) next = e;
+        }
+        if (!next) break;
+
+        uint32_t now = clock_now(ctx, &sc);
+        if ((int32_t)(next->ready_ms - now) > 0) {
+            ctx->cb.delay(next->ready_ms - now, ctx->cb.user_data);
+            sc.est_ms += next->ready_ms - now;
+        }
+
+        next->result = collect_pages(ctx, &sc, next->addr, next->crc,
+                                     next->meas.value_count, &next->data);
+        next->done_ms = clock_now(ctx, &sc);
+    }
+
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+        stats->wall_ms = clock_now(ctx, &sc);
+        stats->bus_ms = sc.bus_ms;
+        stats->sequential_ms = sc.bus_ms + ttt_ms;
+        if (stats->wall_ms > 0) {
+            uint32_t pct = (uint32_t)((uint64_t)sc.bus_ms * 100u / stats->wall_ms);
+            stats->utilization = (uint8_t)(pct > 100 ? 100 : pct);
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            if (entries[i].result == SDI12_OK) stats->ok++;
+        }
+    }
+
+    return SDI12_OK;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Scheduler                                                                */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Job phases (sdi12_sched_job_t.phase). */
+enum {
+    JOB_IDLE = 0,    /**< Waiting for release_ms. */
+    JOB_RELEASED,    /**< Due; waiting for the bus. */
+    JOB_MEASURING    /**< aC! accepted; data ready at ready_ms. */
+};
+
+/** One command/response exchange: command, latency allowance, response. */
+static uint32_t exchange_ms(size_t cmd_chars, size_t resp_chars)
+{
+    return line_time_ms(cmd_chars) + SDI12_RESPONSE_TIMEOUT_MS +
+           line_time_ms(resp_chars);
+}
+
+/** Bus time of the D-page walk for `values` worst-case-width values. */
+static uint32_t job_data_cost(const sdi12_sched_job_t *job)
+{
+    bool conc = job->type == SDI12_MEAS_CONCURRENT;
+    uint8_t per_page = (uint8_t)((conc ? SDI12_C_VALUES_MAX_CHARS
+                                       : SDI12_M_VALUES_MAX_CHARS) /
+                                 SDI12_VALUE_MAX_CHARS);
+    uint32_t ms = 0;
+    for (uint16_t left = job->values; left > 0; ) {
+        uint8_t n = left < per_page ? (uint8_t)left : per_page;
+        ms += exchange_ms(4, 1 + (size_t)n * SDI12_VALUE_MAX_CHARS +
+                             (job->crc ? 3 : 0) + 2);
+        left = (uint16_t)(left - n);
+    }
+    return ms;
+}
+
+/** Bus time of the start exchange (break + aM!/aC! + atttn). */
+static uint32_t job_start_cost(const sdi12_sched_job_t *job)
+{
+    bool conc = job->type == SDI12_MEAS_CONCURRENT;
+    size_t cmd = 3u + (job->crc ? 1u : 0u) + (job->group ? 1u : 0u);
+    return SDI12_BREAK_MS + SDI12_MARKING_MS +
+           exchange_ms(cmd, (conc ? 6u : 5u) + 2u);
+}
+
+/** Longest uninterruptible step of a job — what it can make others wait. */
+static uint32_t job_blocking_ms(const sdi12_sched_job_t *job)
+{
+    if (job->type != SDI12_MEAS_CONCURRENT) return job->cost_ms;
+    uint32_t start = job_start_cost(job);
+    uint32_t data = job->cost_ms - start;
+    return start > data ? start : data;
+}
+
+uint32_t sdi12_sched_job_cost(const sdi12_sched_job_t *job)
+{
+    if (!job) return 0;
+
+    uint32_t ms = job_start_cost(job);
+    if (job->type == SDI12_MEAS_CONCURRENT) {
+        /* The bus is free during ttt, but collecting needs a fresh break */
+        if (job->ttt_s > 0) ms += SDI12_BREAK_MS + SDI12_MARKING_MS;
+    } else {
+        /* aM!: the bus is held through ttt, then the "a<CR><LF>" request */
+        ms += (uint32_t)job->ttt_s * 1000u + line_time_ms(3);
+    }
+    return ms + job_data_cost(job);
+}
+
+sdi12_err_t sdi12_sched_init(sdi12_sched_t *sched, sdi12_master_ctx_t *ctx,
+                              sdi12_sched_job_t *jobs, uint8_t count)
+{
+    if (!sched || !ctx || (!jobs && count > 0)) return SDI12_ERR_INVALID_COMMAND;
+    if (!ctx->cb.millis) return SDI12_ERR_CALLBACK_MISSING;
+
+    uint32_t load = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        sdi12_sched_job_t *j = &jobs[i];
+        if (!sdi12_valid_address(j->addr)) return SDI12_ERR_INVALID_ADDRESS;
+        if ((j->type != SDI12_MEAS_STANDARD && j->type != SDI12_MEAS_CONCURRENT) ||
+            j->group > 9 || j->period_ms == 0) {
+            return SDI12_ERR_INVALID_COMMAND;
+        }
+        j->cost_ms = sdi12_sched_job_cost(j);
+        load += (uint32_t)(((uint64_t)j->cost_ms * 1000u + j->period_ms - 1) /
+                           j->period_ms);
+    }
+    if (load > 1000) return SDI12_ERR_OVERLOAD;
+
+    /* Non-preemptive: each job may first wait out another job's longest step */
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t blocked = 0;
+        for (uint8_t k = 0; k < count; k++) {
+            uint32_t b = job_blocking_ms(&jobs[k]);
+            if (k != i && b > blocked) blocked = b;
+        }
+        uint32_t response = jobs[i].cost_ms + blocked;
+        if (jobs[i].type == SDI12_MEAS_CONCURRENT) {
+            response += (uint32_t)jobs[i].ttt_s * 1000u;
+        }
+        if (response > jobs[i].period_ms) return SDI12_ERR_OVERLOAD;
+    }
+
+    uint32_t now = ctx->cb.millis(ctx->cb.user_data);
+    for (uint8_t i = 0; i < count; i++) {
+        sdi12_sched_job_t *j = &jobs[i];
+        j->runs = 0;
+        j->overruns = 0;
+        j->max_late_ms = 0;
+        j->release_ms = now;
+        j->phase = JOB_IDLE;
+    }
+
+    sched->ctx = ctx;
+    sched->jobs = jobs;
+    sched->count = count;
+    sched->load_permille = (uint16_t)load;
+    return SDI12_OK;
+}
+
+/** Finish a run: record lateness, schedule the next release, notify. */
+static void job_complete(sdi12_sched_job_t *job, sdi12_err_t result, uint32_t now)
+{
+    uint32_t deadline = job->release_ms + job->period_ms;
+    if ((int32_t)(now - deadline) > 0 && now - deadline > job->max_late_ms) {
+        job->max_late_ms = now - deadline;
+    }
+
+    job->result = result;
+    job->runs++;
+    job->phase = JOB_IDLE;
+    job->release_ms = deadline;
+    while ((int32_t)(now - (job->release_ms + job->period_ms)) >= 0) {
+        job->release_ms += job->period_ms;   /* fell a whole period behind */
+        job->overruns++;
+    }
+
+    if (job->on_done) job->on_done(job, job->user_data);
+}
+
+/**
+ * Wait out a measurement that takes ttt_ms. Only `addr`'s own service
+ * request ends the wait early: another sensor's request, noise or a recv
+ * that returns before its timeout does not, since aD0! before ttt runs
+ * out would abort the measurement.
+ */
+static void job_await_service(sdi12_master_ctx_t *ctx, const bus_clock_t *clk,
+                              char addr, uint32_t ttt_ms)
+{
+    uint32_t ready = clock_now(ctx, clk) + ttt_ms;
+    uint32_t left = ttt_ms;
+    while (sdi12_master_wait_service_request(ctx, addr, left) != SDI12_OK) {
+        uint32_t now = clock_now(ctx, clk);
+        if ((int32_t)(ready - now) <= 0) return;
+        if (ready - now >= left) {
+            /* recv gave up without the clock moving: sit out the rest */
+            ctx->cb.delay(left, ctx->cb.user_data);
+            return;
+        }
+        left = ready - now;
+    }
+}
+
+/** Run one step of `job`: start it, or collect its concurrent data. */
+static void job_step(sdi12_master_ctx_t *ctx, sdi12_sched_job_t *job)
+{
+    bus_clock_t clk;                    /* start_ms = 0: absolute millis */
+    memset(&clk, 0, sizeof(clk));
+
+    sdi12_err_t err = SDI12_OK;
+    bool done = true;
+
+    if (job->phase == JOB_MEASURING) {
+        err = collect_pages(ctx, &clk, job->addr, job->crc,
+                            job->expect, &job->data);
+    } else {
+        sdi12_meas_response_t meas;
+        err = clock_start(ctx, &clk, job->addr, job->type, job->group,
+                          job->crc, &meas);
+        job->expect = meas.value_count;   /* the sensor's count wins */
+
+        if (err == SDI12_OK && meas.value_count > 0) {
+            uint32_t ttt_ms = (uint32_t)meas.wait_seconds * 1000u;
+            if (job->type == SDI12_MEAS_CONCURRENT && ttt_ms > 0) {
+                job->ready_ms = clock_now(ctx, &clk) + ttt_ms;
+                job->phase = JOB_MEASURING;
+                done = false;
+            } else {
+                if (ttt_ms > 0) job_await_service(ctx, &clk, job->addr, ttt_ms);
+                err = collect_pages(ctx, &clk, job->addr, job->crc,
+                                    job->expect, &job->data);
+            }
+        } else if (err == SDI12_OK) {
+            memset(&job->data, 0, sizeof(job->data));
+        }
+    }
+
+    if (done) job_complete(job, err, clock_now(ctx, &clk));
+}
+
+uint32_t sdi12_sched_poll(sdi12_sched_t *sched)
+{
+    if (!sched || !sched->ctx || sched->count == 0) return SDI12_POLL_IDLE;
+
+    sdi12_master_ctx_t *ctx = sched->ctx;
+    uint32_t now = ctx->cb.millis(ctx->cb.user_data);
+
+    /* Earliest deadline among jobs with something to do now */
+    sdi12_sched_job_t *pick = NULL;
+    uint32_t wait = SDI12_POLL_IDLE;
+    for (uint8_t i = 0; i < sched->count; i++) {
+        sdi12_sched_job_t *j = &sched->jobs[i];
+
+        if (j->phase == JOB_IDLE) {
+            if ((int32_t)(now - j->release_ms) < 0) {
+                if (j->release_ms - now < wait) wait = j->release_ms - now;
+                continue;
+            }
+            j->phase = JOB_RELEASED;
+        }
+        if (j->phase == JOB_RELEASED) {
+            /* Not started before its next release: drop this one */
+            while ((int32_t)(now - (j->release_ms + j->period_ms)) >= 0) {
+                j->release_ms += j->period_ms;
+                j->overruns++;
+            }
+        } else if ((int32_t)(now - j->ready_ms) < 0) {
+            if (j->ready_ms - now < wait) wait = j->ready_ms - now;
+            continue;
+        }
+
+        if (!pick || (int32_t)((j->release_ms + j->period_ms) -
+                               (pick->release_ms + pick->period_ms)) < 0) {
+            pick = j;
+        }
+    }
+
+    if (!pick) return wait;
+    job_step(ctx, pick);
+    return 0;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Metadata Cache                                                           */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Blob header: magic, format version, entry count. */
+#define META_MAGIC_0  'S'
+#define META_MAGIC_1  'M'
+#define META_FORMAT   1
+#define META_HDR_LEN  4
+
+sdi12_err_t sdi12_meta_init(sdi12_meta_cache_t *cache,
+                            sdi12_meta_entry_t *entries, size_t count)
+{
+    if (!cache || !entries) return SDI12_ERR_INVALID_COMMAND;
+
+    memset(entries, 0, count * sizeof(*entries));
+    cache->entries = entries;
+    cache->count = count;
+    return SDI12_OK;
+}
+
+sdi12_meta_entry_t *sdi12_meta_find(const sdi12_meta_cache_t *cache, char addr)
+{
+    if (!cache || !cache->entries || !sdi12_valid_address(addr)) return NULL;
+    for (size_t i = 0; i < cache->count; i++) {
+        if (cache->entries[i].addr == addr) return &cache->entries[i];
+    }
+    return NULL;
+}
+
+/** aI! — copy the identification string after the address into `ident`. */
+static sdi12_err_t meta_read_ident(sdi12_master_ctx_t *ctx, char addr, char *ident)
+{
+    char cmd[4];
+    snprintf(cmd, sizeof(cmd), "%cI!", addr);
+
+    sdi12_err_t err = sdi12_master_transact(ctx, cmd, SDI12_RESPONSE_TIMEOUT_MS);
+    if (err != SDI12_OK) return err;
+
+    size_t len = trim_crlf(ctx->resp_buf, ctx->resp_len);
+    if (len < 20) return SDI12_ERR_PARSE_FAILED;   /* 1+2+8+6+3 */
+    if (ctx->resp_buf[0] != addr) return SDI12_ERR_INVALID_ADDRESS;
+
+    len--;
+    if (len > SDI12_META_IDENT_LEN) len = SDI12_META_IDENT_LEN;
+    memcpy(ident, ctx->resp_buf + 1, len);
+    ident[len] = '\0';
+    return SDI12_OK;
+}
+
+/** Parameters listed for a group: C may report more than M's nine. */
+static uint8_t meta_group_params(const sdi12_meta_entry_t *e, uint8_t group)
+{
+    return e->c_count[group] > e->m_count[group] ? e->c_count[group]
+                                                  : e->m_count[group];
+}
+
+/** Copy `src` into a fixed field, truncating. */
+static void meta_copy(char *dst, size_t size, const char *src)
+{
+    size_t n = strlen(src);
+    if (n >= size) n = size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+}
+
+/** Crawl groups and parameters into `e`, whose ident is already set. */
+static sdi12_err_t meta_fill(sdi12_master_ctx_t *ctx, char addr,
+                             sdi12_meta_entry_t *e)
+{
+    char body[4];
+
+    for (uint8_t g = 0; g < SDI12_MAX_MEAS_GROUPS; g++) {
+        sdi12_meas_response_t r;
+
+        if (g > 0) snprintf(body, sizeof(body), "M%u", g);
+        else       snprintf(body, sizeof(body), "M");
+        sdi12_err_t err = sdi12_master_identify_measurement(
+            ctx, addr, body, SDI12_MEAS_STANDARD, &r);
+        if (err != SDI12_OK) {
+            if (g == 0) return err;
+            break;
+        }
+        e->m_count[g] = (uint8_t)r.value_count;
+
+        body[0] = 'C';   /* sensors without concurrent support leave 0 */
+        if (sdi12_master_identify_measurement(ctx, addr, body,
+                                              SDI12_MEAS_CONCURRENT, &r) == SDI12_OK) {
+            e->c_count[g] = (uint8_t)r.value_count;
+        }
+
+        if (g > 0 && meta_group_params(e, g) == 0) break;   /* first empty group */
+    }
+
+    for (uint8_t g = 0; g < SDI12_MAX_MEAS_GROUPS; g++) {
+        uint8_t n = meta_group_params(e, g);
+        char kind = e->c_count[g] > e->m_count[g] ? 'C' : 'M';
+        if (g > 0) snprintf(body, sizeof(body), "%c%u", kind, g);
+        else       snprintf(body, sizeof(body), "%c", kind);
+
+        for (uint8_t i = 1; i <= n; i++) {
+            if (e->param_count >= SDI12_META_MAX_PARAMS) return SDI12_OK;
+
+            /* A failed query keeps its slot, empty, so numbering holds */
+            sdi12_param_meta_t *p = &e->params[e->param_count++];
+            sdi12_param_meta_response_t pm;
+            if (sdi12_master_identify_param(ctx, addr, body, i, &pm) == SDI12_OK) {
+                meta_copy(p->shef, sizeof(p->shef), pm.shef);
+                meta_copy(p->units, sizeof(p->units), pm.units);
+            }
+        }
+    }
+    return SDI12_OK;
+}
+
+sdi12_err_t sdi12_meta_crawl(sdi12_master_ctx_t *ctx, char addr,
+                             sdi12_meta_entry_t *entry)
+{
+    if (!ctx || !entry) return SDI12_ERR_INVALID_COMMAND;
     if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
 
-    char cmd[SDI12_CMD_MAX_CHARS + 4];
-    snprintf(cmd, sizeof(cmd), "%cX%s!", addr, xcmd);
+    memset(entry, 0, sizeof(*entry));
+    sdi12_err_t err = meta_read_ident(ctx, addr, entry->ident);
+    if (err == SDI12_OK) err = meta_fill(ctx, addr, entry);
+    if (err != SDI12_OK) {
+        memset(entry, 0, sizeof(*entry));
+        return err;
+    }
+    entry->addr = addr;
+    return SDI12_OK;
+}
 
-    sdi12_err_t err = sdi12_master_transact(ctx, cmd, timeout_ms);
-    if (err != SDI12_OK) return err;
+sdi12_err_t sdi12_meta_refresh(sdi12_master_ctx_t *ctx, sdi12_meta_cache_t *cache,
+                               char addr, const sdi12_meta_entry_t **entry,
+                               bool *crawled)
+{
+    if (!ctx || !cache || !cache->entries || !entry) return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+    if (crawled) *crawled = false;
 
-    size_t len = ctx->resp_len;
-    if (len > *resp_len) len = *resp_len;
+    char ident[SDI12_META_IDENT_LEN + 1];
+    sdi12_err_t err = meta_read_ident(ctx, addr, ident);
+    if (err != SDI12_OK) return err;
 
-    memcpy(resp_buf, ctx->resp_buf, len);
-    *resp_len = len;
+    sdi12_meta_entry_t *e = sdi12_meta_find(cache, addr);
+    if (e && strcmp(e->ident, ident) == 0) {
+        *entry = e;
+        return SDI12_OK;
+    }
 
+    for (size_t i = 0; !e && i < cache->count; i++) {
+        if (cache->entries[i].addr == '\0') e = &cache->entries[i];
+    }
+    if (!e) return SDI12_ERR_BUFFER_OVERFLOW;
+
+    /* New or changed sensor: crawl, reusing the ident just read */
+    memset(e, 0, sizeof(*e));
+    meta_copy(e->ident, sizeof(e->ident), ident);
+    err = meta_fill(ctx, addr, e);
+    if (err != SDI12_OK) {
+        memset(e, 0, sizeof(*e));
+        return err;
+    }
+    e->addr = addr;
+    if (crawled) *crawled = true;
+    *entry = e;
     return SDI12_OK;
 }
 
-sdi12_err_t sdi12_master_extended_multiline(sdi12_master_ctx_t *ctx,
-                                             char addr,
-                                             const char *xcmd,
-                                             char *resp_buf, size_t resp_bufsize,
-                                             size_t *resp_len,
-                                             uint8_t *line_count,
-                                             uint32_t timeout_ms)
+const sdi12_param_meta_t *sdi12_meta_param(const sdi12_meta_entry_t *entry,
+                                           uint8_t group, uint8_t n)
 {
-    if (!ctx || !xcmd || !resp_buf || !resp_len) return SDI12_ERR_INVALID_COMMAND;
-    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+    if (!entry || group >= SDI12_MAX_MEAS_GROUPS) return NULL;
+    if (n == 0 || n > meta_group_params(entry, group)) return NULL;
 
-    char cmd[SDI12_CMD_MAX_CHARS + 4];
-    snprintf(cmd, sizeof(cmd), "%cX%s!", addr, xcmd);
+    size_t idx = n - 1u;
+    for (uint8_t g = 0; g < group; g++) idx += meta_group_params(entry, g);
+    return idx < entry->param_count ? &entry->params[idx] : NULL;
+}
 
-    /* Send the command */
-    sdi12_err_t err = send_command(ctx, cmd);
-    if (err != SDI12_OK) return err;
+/** Bounded byte writer for the blob. */
+typedef struct {
+    uint8_t *buf;
+    size_t   cap;
+    size_t   pos;
+    bool     ok;
+} meta_writer_t;
 
-    /* Receive the first line */
-    err = recv_response(ctx, timeout_ms);
-    if (err != SDI12_OK) return err;
+static void meta_put(meta_writer_t *w, const void *data, size_t n)
+{
+    if (!w->ok || w->cap - w->pos < n) {
+        w->ok = false;
+        return;
+    }
+    memcpy(w->buf + w->pos, data, n);
+    w->pos += n;
+}
 
-    /* Copy first line into output buffer */
-    size_t total = 0;
-    uint8_t lines = 0;
+static void meta_put_byte(meta_writer_t *w, uint8_t b)
+{
+    meta_put(w, &b, 1);
+}
 
-    if (ctx->resp_len > 0) {
-        size_t copy = ctx->resp_len;
-        if (copy > resp_bufsize) copy = resp_bufsize;
-        memcpy(resp_buf, ctx->resp_buf, copy);
-        total = copy;
-        lines = 1;
+/** Length-prefixed string. */
+static void meta_put_str(meta_writer_t *w, const char *s)
+{
+    size_t n = strlen(s);
+    meta_put_byte(w, (uint8_t)n);
+    meta_put(w, s, n);
+}
+
+sdi12_err_t sdi12_meta_serialize(const sdi12_meta_cache_t *cache,
+                                 uint8_t *buf, size_t cap, size_t *len)
+{
+    if (!cache || !cache->entries || !buf || !len) return SDI12_ERR_INVALID_COMMAND;
+
+    meta_writer_t w = { buf, cap, 0, true };
+    uint8_t used = 0;
+    for (size_t i = 0; i < cache->count; i++) {
+        if (cache->entries[i].addr && used < UINT8_MAX) used++;
     }
 
-    /* Keep collecting lines as long as data arrives within the multi-line gap */
-    while (total < resp_bufsize) {
-        ctx->resp_len = ctx->cb.recv(ctx->resp_buf, sizeof(ctx->resp_buf) - 1,
-                                      SDI12_MULTILINE_GAP_MS, ctx->cb.user_data);
-        if (ctx->resp_len == 0)
-            break; /* no more lines — 150ms gap elapsed */
+    const uint8_t hdr[META_HDR_LEN] = { META_MAGIC_0, META_MAGIC_1, META_FORMAT, used };
+    meta_put(&w, hdr, sizeof(hdr));
 
-        ctx->resp_buf[ctx->resp_len] = '\0';
+    uint8_t written = 0;
+    for (size_t i = 0; i < cache->count && written < used; i++) {
+        const sdi12_meta_entry_t *e = &cache->entries[i];
+        if (!e->addr) continue;
+        written++;
 
-        size_t copy = ctx->resp_len;
-        if (total + copy > resp_bufsize) copy = resp_bufsize - total;
-        memcpy(resp_buf + total, ctx->resp_buf, copy);
-        total += copy;
-        lines++;
+        meta_put_byte(&w, (uint8_t)e->addr);
+        meta_put_str(&w, e->ident);
+
+        uint8_t groups = SDI12_MAX_MEAS_GROUPS;
+        while (groups > 0 && meta_group_params(e, groups - 1) == 0) groups--;
+        meta_put_byte(&w, groups);
+        for (uint8_t g = 0; g < groups; g++) {
+            meta_put_byte(&w, e->m_count[g]);
+            meta_put_byte(&w, e->c_count[g]);
+        }
+
+        meta_put_byte(&w, e->param_count);
+        for (uint8_t p = 0; p < e->param_count; p++) {
+            meta_put_str(&w, e->params[p].shef);
+            meta_put_str(&w, e->params[p].units);
+        }
     }
 
-    *resp_len = total;
-    if (line_count) *line_count = lines;
+    if (w.ok) {
+        uint16_t crc = sdi12_crc16(buf, w.pos);
+        meta_put_byte(&w, (uint8_t)(crc & 0xFF));
+        meta_put_byte(&w, (uint8_t)(crc >> 8));
+    }
+    if (!w.ok) return SDI12_ERR_BUFFER_OVERFLOW;
+
+    *len = w.pos;
+    return SDI12_OK;
+}
+
+/** Bounded byte reader for the blob. */
+typedef struct {
+    const uint8_t *buf;
+    size_t         len;
+    size_t         pos;
+    bool           ok;
+} meta_reader_t;
+
+static uint8_t meta_get_byte(meta_reader_t *r)
+{
+    if (!r->ok || r->pos >= r->len) {
+        r->ok = false;
+        return 0;
+    }
+    return r->buf[r->pos++];
+}
+
+/** Length-prefixed string into a field of `size` bytes. */
+static void meta_get_str(meta_reader_t *r, char *dst, size_t size)
+{
+    size_t n = meta_get_byte(r);
+    if (!r->ok || n >= size || r->len - r->pos < n) {
+        r->ok = false;
+        return;
+    }
+    memcpy(dst, r->buf + r->pos, n);
+    dst[n] = '\0';
+    r->pos += n;
+}
 
+sdi12_err_t sdi12_meta_deserialize(sdi12_meta_cache_t *cache,
+                                   const uint8_t *buf, size_t len)
+{
+    if (!cache || !cache->entries || !buf) return SDI12_ERR_INVALID_COMMAND;
+    memset(cache->entries, 0, cache->count * sizeof(*cache->entries));
+
+    if (len < META_HDR_LEN + 2 || buf[0] != META_MAGIC_0 ||
+        buf[1] != META_MAGIC_1 || buf[2] != META_FORMAT) {
+        return SDI12_ERR_PARSE_FAILED;
+    }
+    uint16_t crc = (uint16_t)(buf[len - 2] | (buf[len - 1] << 8));
+    if (sdi12_crc16(buf, len - 2) != crc) return SDI12_ERR_CRC_MISMATCH;
+    if (buf[3] > cache->count) return SDI12_ERR_BUFFER_OVERFLOW;
+
+    meta_reader_t r = { buf, len - 2, META_HDR_LEN, true };
+    for (uint8_t i = 0; i < buf[3] && r.ok; i++) {
+        sdi12_meta_entry_t *e = &cache->entries[i];
+
+        char addr = (char)meta_get_byte(&r);
+        meta_get_str(&r, e->ident, sizeof(e->ident));
+
+        uint8_t groups = meta_get_byte(&r);
+        if (groups > SDI12_MAX_MEAS_GROUPS) r.ok = false;
+        for (uint8_t g = 0; g < groups && r.ok; g++) {
+            e->m_count[g] = meta_get_byte(&r);
+            e->c_count[g] = meta_get_byte(&r);
+        }
+
+        e->param_count = meta_get_byte(&r);
+        if (e->param_count > SDI12_META_MAX_PARAMS) r.ok = false;
+        for (uint8_t p = 0; p < e->param_count && r.ok; p++) {
+            meta_get_str(&r, e->params[p].shef, sizeof(e->params[p].shef));
+            meta_get_str(&r, e->params[p].units, sizeof(e->params[p].units));
+        }
+
+        if (!sdi12_valid_address(addr) || sdi12_meta_find(cache, addr)) r.ok = false;
+        e->addr = addr;
+    }
+
+    if (!r.ok || r.pos != r.len) {
+        memset(cache->entries, 0, cache->count * sizeof(*cache->entries));
+        return SDI12_ERR_PARSE_FAILED;
+    }
     return SDI12_OK;
 }
 
@@ -603,6 +2412,7 @@ sdi12_err_t sdi12_master_parse_meas_response(const char *resp_str, size_t len,
     }
 
     resp->value_count = (uint16_t)count;
+    resp->type = type;
     return SDI12_OK;
 }
 
@@ -613,65 +2423,17 @@ sdi12_err_t sdi12_master_parse_data_values(const char *resp_str, size_t len,
                                             bool verify_crc)
 {
     if (!resp_str || !values || !count) return SDI12_ERR_INVALID_COMMAND;
+    return parse_values(resp_str, len, values, NULL, NULL, max_values, count, verify_crc, NULL);
+}
 
-    *count = 0;
-
-    /* If CRC verification requested, check and strip CRC (last 3 chars) */
-    size_t data_len = len;
-    if (verify_crc && data_len >= 3) {
-        /* We need to reconstruct the full response with address for CRC check.
-         * Since the caller has stripped the address, we just verify the CRC
-         * bytes at the end of the data. The CRC covers address + values. */
-        /* For simplicity, just strip the 3 CRC chars — the caller should
-         * verify CRC at a higher level with the full response buffer. */
-        data_len -= 3;
-    }
-
-    /* Parse sign-prefixed values: +1.23-4.56+7.89 */
-    size_t pos = 0;
-    while (pos < data_len && *count < max_values) {
-        /* Skip whitespace */
-        while (pos < data_len && resp_str[pos] == ' ') pos++;
-        if (pos >= data_len) break;
-
-        /* Expect + or - */
-        if (resp_str[pos] != '+' && resp_str[pos] != '-') {
-            pos++;
-            continue;
-        }
-
-        /* Extract the value string */
-        size_t start = pos;
-        pos++; /* skip sign */
-        while (pos < data_len && (isdigit((unsigned char)resp_str[pos]) ||
-               resp_str[pos] == '.')) {
-            pos++;
-        }
-
-        if (pos > start + 1) {
-            /* Parse the numeric value */
-            char vbuf[SDI12_VALUE_MAX_CHARS + 1];
-            size_t vlen = pos - start;
-            if (vlen > SDI12_VALUE_MAX_CHARS) vlen = SDI12_VALUE_MAX_CHARS;
-
-            memcpy(vbuf, resp_str + start, vlen);
-            vbuf[vlen] = '\0';
-
-            values[*count].value = (float)strtod(vbuf, NULL);
-
-            /* Count decimal places */
-            const char *dot = (const char *)memchr(vbuf, '.', vlen);
-            if (dot) {
-                values[*count].decimals = (uint8_t)(vlen - (size_t)(dot - vbuf) - 1);
-            } else {
-                values[*count].decimals = 0;
-            }
-
-            (*count)++;
-        }
-    }
-
-    return SDI12_OK;
+sdi12_err_t sdi12_master_parse_data_decimals(const char *resp_str, size_t len,
+                                             sdi12_decimal_t *values,
+                                             uint8_t max_values,
+                                             uint8_t *count,
+                                             bool verify_crc)
+{
+    if (!resp_str || !values || !count) return SDI12_ERR_INVALID_COMMAND;
+    return parse_values(resp_str, len, NULL, values, NULL, max_values, count, verify_crc, NULL);
 }
 
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -683,6 +2445,25 @@ sdi12_err_t sdi12_master_get_hv_data(sdi12_master_ctx_t *ctx,
                                       char *raw_buf, size_t *raw_len)
 {
     if (!ctx || !raw_buf || !raw_len) return SDI12_ERR_INVALID_COMMAND;
+
+    sdi12_span_t view;
+    sdi12_err_t err = sdi12_master_get_hv_data_view(ctx, addr, page, &view);
+    if (err != SDI12_OK) return err;
+
+    size_t data_len = view.len;
+    if (data_len > *raw_len) data_len = *raw_len;
+
+    memcpy(raw_buf, view.ptr, data_len);
+    *raw_len = data_len;
+
+    return data_len < view.len ? SDI12_ERR_BUFFER_OVERFLOW : SDI12_OK;
+}
+
+sdi12_err_t sdi12_master_get_hv_data_view(sdi12_master_ctx_t *ctx,
+                                          char addr, uint16_t page,
+                                          sdi12_span_t *raw)
+{
+    if (!ctx || !raw) return SDI12_ERR_INVALID_COMMAND;
     if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
 
     char cmd[12];
@@ -695,12 +2476,8 @@ sdi12_err_t sdi12_master_get_hv_data(sdi12_master_ctx_t *ctx,
     size_t len = trim_crlf(ctx->resp_buf, ctx->resp_len);
     if (len < 1) return SDI12_ERR_PARSE_FAILED;
 
-    size_t data_len = len - 1; /* skip address */
-    if (data_len > *raw_len) data_len = *raw_len;
-
-    memcpy(raw_buf, ctx->resp_buf + 1, data_len);
-    *raw_len = data_len;
-
+    raw->ptr = ctx->resp_buf + 1;
+    raw->len = len - 1;
     return SDI12_OK;
 }
 
@@ -708,6 +2485,64 @@ sdi12_err_t sdi12_master_get_hv_data(sdi12_master_ctx_t *ctx,
 /*  High-Volume Binary Data Retrieval (§5.2)                                 */
 /* ────────────────────────────────────────────────────────────────────────── */
 
+/**
+ * Receive one binary packet after its aDBn! has gone out. The payload is
+ * streamed into `payload` (capacity *len) while the CRC is folded in, so
+ * nothing is staged; the excess of an oversized packet passes through a
+ * small spill buffer. *len returns the full payload size.
+ */
+static sdi12_err_t recv_binary_packet(sdi12_master_ctx_t *ctx,
+                                      sdi12_bintype_t *type,
+                                      void *payload, size_t *len)
+{
+    /*
+     * Binary packet format per §5.2 Table 14:
+     *   addr(1) + pkt_size(2 LE) + type(1) + payload(N) + CRC(2 LE)
+     * All fields after address are raw binary (8 data bits, no parity).
+     */
+    uint8_t hdr[4];
+    sdi12_err_t err = recv_exact(ctx, (char *)hdr, sizeof(hdr), SDI12_RESPONSE_TIMEOUT_MS);
+    if (err != SDI12_OK) return err;
+
+    uint16_t pkt_size = (uint16_t)(hdr[1] | ((uint16_t)hdr[2] << 8));
+    *type = (sdi12_bintype_t)hdr[3];
+    if (pkt_size > SDI12_BIN_MAX_PAYLOAD) return SDI12_ERR_BUFFER_OVERFLOW;
+
+    uint16_t crc = sdi12_crc16_update(0x0000, hdr, sizeof(hdr));
+
+    char *dst = (char *)payload;
+    size_t cap = *len;
+    size_t got = 0;
+    while (got < pkt_size) {
+        char spill[16];
+        char *chunk = spill;
+        size_t n = (size_t)pkt_size - got;
+        if (got < cap) {
+            chunk = dst + got;
+            if (n > cap - got) n = cap - got;
+        } else if (n > sizeof(spill)) {
+            n = sizeof(spill);
+        }
+        err = recv_exact(ctx, chunk, n, SDI12_RESPONSE_TIMEOUT_MS);
+        if (err != SDI12_OK) return err;
+        crc = sdi12_crc16_update(crc, chunk, n);
+        got += n;
+    }
+
+    uint8_t rx_crc[2];
+    err = recv_exact(ctx, (char *)rx_crc, sizeof(rx_crc), SDI12_RESPONSE_TIMEOUT_MS);
+    if (err != SDI12_OK) return err;
+    if (crc != (uint16_t)(rx_crc[0] | ((uint16_t)rx_crc[1] << 8)))
+        return SDI12_ERR_CRC_MISMATCH;
+
+    *len = pkt_size;
+
+    /* Store total packet size for timing layer access */
+    ctx->resp_len = sizeof(hdr) + (size_t)pkt_size + sizeof(rx_crc);
+
+    return SDI12_OK;
+}
+
 sdi12_err_t sdi12_master_get_hv_binary_data(sdi12_master_ctx_t *ctx,
                                             char addr, uint16_t page,
                                             sdi12_bintype_t *out_type,
@@ -725,84 +2560,393 @@ sdi12_err_t sdi12_master_get_hv_binary_data(sdi12_master_ctx_t *ctx,
     sdi12_err_t err = send_command(ctx, cmd);
     if (err != SDI12_OK) return err;
 
-    /*
-     * Binary packet format per §5.2 Table 14:
-     *   addr(1) + pkt_size(2 LE) + type(1) + payload(N) + CRC(2 LE)
-     * All fields after address are raw binary (8 data bits, no parity).
-     */
+    return recv_binary_packet(ctx, out_type, out_payload, out_len);
+}
 
-    /* Read header: address(1) + packet_size(2) = 3 bytes */
-    char hdr[4];
-    err = recv_exact(ctx, hdr, 3, SDI12_RESPONSE_TIMEOUT_MS);
-    if (err != SDI12_OK) return err;
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  High-Volume Collection                                                   */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** State of one sdi12_master_collect_hv() or sdi12_master_collect_ha_values() call. */
+typedef struct {
+    sdi12_master_ctx_t *ctx;
+    sdi12_hv_arena_t   *arena;     /**< NULL when HA pages are parsed to values. */
+    bus_clock_t         clk;
+    char                addr;
+    bool                binary;
+    bool                crc;
+    size_t              text_len;  /**< Trimmed HA reply waiting in resp_buf. */
+    uint16_t            retried;
+    uint16_t            breaks;
+} hv_run_t;
+
+void sdi12_hv_arena_init(sdi12_hv_arena_t *arena, void *buf, size_t cap,
+                         sdi12_hv_page_t *pages, uint16_t max_pages)
+{
+    if (!arena) return;
+    arena->buf = (uint8_t *)buf;
+    arena->cap = buf ? cap : 0;
+    arena->used = 0;
+    arena->pages = pages;
+    arena->max_pages = pages ? max_pages : 0;
+    arena->page_count = 0;
+    arena->value_count = 0;
+}
 
-    uint16_t pkt_size = (uint8_t)hdr[1] | ((uint16_t)(uint8_t)hdr[2] << 8);
+/** Wake the bus if needed and send aD<page>! or aDB<page>!. */
+static void hv_request(hv_run_t *r, uint16_t page)
+{
+    char cmd[12];
+    if (r->binary) snprintf(cmd, sizeof(cmd), "%cDB%u!", r->addr, page);
+    else           snprintf(cmd, sizeof(cmd), "%cD%u!", r->addr, page);
 
-    /* Read data type (1 byte) */
-    char type_byte;
-    err = recv_exact(ctx, &type_byte, 1, SDI12_RESPONSE_TIMEOUT_MS);
-    if (err != SDI12_OK) return err;
+    if (clock_wake(r->ctx, &r->clk)) r->breaks++;
+    send_command(r->ctx, cmd);
+    r->clk.bus_ms += line_time_ms(strlen(cmd));
+    r->clk.est_ms += line_time_ms(strlen(cmd));
+}
 
-    *out_type = (sdi12_bintype_t)(uint8_t)type_byte;
+/**
+ * Receive the reply to the page just requested and count its values. An
+ * HB packet is checked and stored in place as it streams in; HA text is
+ * left in resp_buf for hv_store_text(), so the next request can go first.
+ */
+static sdi12_err_t hv_receive(hv_run_t *r, uint16_t page, uint16_t *values)
+{
+    sdi12_master_ctx_t *ctx = r->ctx;
+    sdi12_hv_arena_t *a = r->arena;
+    size_t room = a ? a->cap - a->used : SIZE_MAX;   /* no arena: values only */
+    sdi12_err_t err;
+    *values = 0;
+
+    if (r->binary) {
+        sdi12_bintype_t type = SDI12_BINTYPE_INVALID;
+        size_t len = room;
+        err = recv_binary_packet(ctx, &type, a->buf + a->used, &len);
+        if (err == SDI12_OK && len > room) err = SDI12_ERR_BUFFER_OVERFLOW;
+        if (err == SDI12_OK) {
+            size_t size = sdi12_bintype_size(type);
+            sdi12_hv_page_t *p = &a->pages[page];
+            p->offset = (uint32_t)a->used;
+            p->len = (uint16_t)len;
+            p->type = type;
+            p->values = size ? (uint16_t)(len / size) : 0;
+            a->used += len;
+            *values = p->values;
+        } else if (err != SDI12_ERR_TIMEOUT) {
+            char c;   /* whatever is left of a bad packet */
+            while (ctx->cb.recv(&c, 1, rx_gap_ms(ctx, 0), ctx->cb.user_data) > 0) { }
+        }
+    } else {
+        err = recv_response(ctx, SDI12_RESPONSE_TIMEOUT_MS,
+                            sdi12_master_response_len(ctx->cmd_buf));
+        if (err == SDI12_OK) {
+            size_t len = trim_crlf(ctx->resp_buf, ctx->resp_len);
+            size_t end = len;
+            if (r->crc) end = len >= 3 ? len - 3 : 0;
+            if (end < 1 || ctx->resp_buf[0] != r->addr) {
+                err = SDI12_ERR_PARSE_FAILED;
+            } else if (end - 1 > room) {
+                err = SDI12_ERR_BUFFER_OVERFLOW;
+            } else {
+                for (size_t i = 1; i < end; i++) {
+                    if (ctx->resp_buf[i] == '+' || ctx->resp_buf[i] == '-') (*values)++;
+                }
+                r->text_len = len;
+            }
+        }
+    }
 
-    /* Read payload + CRC into a local buffer */
-    size_t tail_len = (size_t)pkt_size + 2; /* payload + CRC(2) */
-    char tail[SDI12_BIN_MAX_PAYLOAD + 2];
-    if (pkt_size > SDI12_BIN_MAX_PAYLOAD) return SDI12_ERR_BUFFER_OVERFLOW;
+    size_t chars = err == SDI12_OK ? ctx->resp_len : 0;
+    r->clk.bus_ms += line_time_ms(chars);
+    r->clk.est_ms += line_time_ms(chars);
+    if (err == SDI12_ERR_TIMEOUT) r->clk.est_ms += SDI12_RESPONSE_TIMEOUT_MS;
+    r->clk.last_bus = clock_now(ctx, &r->clk);
+    return err;
+}
 
-    err = recv_exact(ctx, tail, tail_len, SDI12_RESPONSE_TIMEOUT_MS);
-    if (err != SDI12_OK) return err;
+/** Check the CRC of the HA page in resp_buf and append its text to the arena. */
+static sdi12_err_t hv_store_text(hv_run_t *r, uint16_t page, uint16_t values)
+{
+    const char *line = r->ctx->resp_buf;
+    size_t len = r->text_len;
+    if (r->crc) {
+        char expect[4];
+        len -= 3;
+        sdi12_crc_encode_ascii(sdi12_crc16(line, len), expect);
+        if (memcmp(line + len, expect, 3) != 0) return SDI12_ERR_CRC_MISMATCH;
+    }
+
+    sdi12_hv_arena_t *a = r->arena;
+    sdi12_hv_page_t *p = &a->pages[page];
+    p->offset = (uint32_t)a->used;
+    p->len = (uint16_t)(len - 1);
+    p->type = SDI12_BINTYPE_INVALID;
+    p->values = values;
+    memcpy(a->buf + a->used, line + 1, len - 1);
+    a->used += len - 1;
+    return SDI12_OK;
+}
 
-    /* Verify CRC: computed over addr + pkt_size(2) + type(1) + payload(N) */
-    size_t crc_data_len = 4 + (size_t)pkt_size;
+/** Give a failed exchange the retry spacing before the next command goes out. */
+static void hv_pace(hv_run_t *r)
+{
+    sdi12_master_ctx_t *ctx = r->ctx;
+    uint32_t since = ctx->cb.millis
+        ? ctx->cb.millis(ctx->cb.user_data) - ctx->last_bus_ms
+        : SDI12_RESPONSE_TIMEOUT_MS;
+    if (since < SDI12_RETRY_MIN_MS) {
+        ctx->cb.delay(SDI12_RETRY_MIN_MS - since, ctx->cb.user_data);
+        r->clk.est_ms += SDI12_RETRY_MIN_MS - since;
+    }
+}
 
-    /* Assemble contiguous CRC input into resp_buf for computation.
-     * Total ≤ 4 + 1000 = 1004 which exceeds resp_buf.  Use a different
-     * approach: compute CRC incrementally over hdr(3) + type(1) + payload. */
-    {
-        /* Compute CRC over header bytes + type byte + payload bytes */
-        uint16_t crc = 0;
-        /* We need a contiguous buffer.  Build one from the pieces: */
-        /* For small payloads (our typical case), stack is fine. */
-        uint8_t crc_buf[SDI12_BIN_MAX_PAYLOAD + SDI12_BIN_PKT_OVERHEAD];
-        memcpy(crc_buf, hdr, 3);
-        crc_buf[3] = (uint8_t)type_byte;
-        if (pkt_size > 0)
-            memcpy(crc_buf + 4, tail, pkt_size);
+/** First page at or after `from` that has not arrived intact, or -1. */
+static int32_t hv_next_failed(const sdi12_hv_arena_t *a, uint16_t from)
+{
+    for (uint16_t i = from; i < a->page_count; i++) {
+        if (a->pages[i].status != SDI12_OK) return i;
+    }
+    return -1;
+}
 
-        crc = sdi12_crc16(crc_buf, crc_data_len);
+/**
+ * One pass over the pages with a command always one page ahead: page k's
+ * reply is received and counted, page k+1 is requested, and only then is
+ * page k checked, stored and reported. The first pass walks 0, 1, 2, …
+ * until `expected` values or an empty page; a retry pass visits the
+ * failed pages only.
+ */
+static sdi12_err_t hv_walk(hv_run_t *r, bool retry, uint16_t expected,
+                           sdi12_hv_page_fn on_page, void *user_data)
+{
+    sdi12_hv_arena_t *a = r->arena;
+    uint16_t limit = a->max_pages < SDI12_HV_MAX_PAGES ? a->max_pages : SDI12_HV_MAX_PAGES;
+    uint16_t counted = a->value_count;
+    uint8_t misses = 0;
+    bool full = false;
+
+    int32_t page = retry ? hv_next_failed(a, 0) : 0;
+    if (page < 0) return SDI12_OK;
+    if (page >= limit) return SDI12_ERR_BUFFER_OVERFLOW;
+    hv_request(r, (uint16_t)page);
+
+    while (page >= 0) {
+        uint16_t values = 0;
+        sdi12_err_t err = hv_receive(r, (uint16_t)page, &values);
+        if (err == SDI12_ERR_BUFFER_OVERFLOW) return err;
+
+        int32_t next = -1;
+        bool end = !retry && err == SDI12_OK && values == 0;
+        if (retry) {
+            r->retried++;
+            next = hv_next_failed(a, (uint16_t)(page + 1));
+        } else {
+            if (!end) a->page_count = (uint16_t)(page + 1);
+            if (err == SDI12_OK) {
+                counted = (uint16_t)(counted + values);
+                misses = 0;
+            } else {
+                misses++;
+            }
+            if (!end && counted < expected && misses <= SDI12_LINK_RETRIES) {
+                if (page + 1 < limit) next = page + 1;
+                else full = limit < SDI12_HV_MAX_PAGES;
+            }
+        }
 
-        uint16_t received_crc = (uint8_t)tail[pkt_size] |
-                                ((uint16_t)(uint8_t)tail[pkt_size + 1] << 8);
+        if (err != SDI12_OK) hv_pace(r);
+        if (next >= 0) hv_request(r, (uint16_t)next);
+        if (end) break;   /* past the data: nothing to store */
 
-        if (crc != received_crc) return SDI12_ERR_CRC_MISMATCH;
+        /* Page k while page k+1 is on the wire */
+        if (err == SDI12_OK && !r->binary) {
+            err = hv_store_text(r, (uint16_t)page, values);
+            if (err != SDI12_OK && !retry) counted = (uint16_t)(counted - values);
+        }
+        sdi12_hv_page_t *p = &a->pages[page];
+        p->status = err;
+        if (err == SDI12_OK) {
+            a->value_count = (uint16_t)(a->value_count + p->values);
+            if (on_page) on_page(r->addr, (uint16_t)page, a, user_data);
+        } else {
+            p->len = 0;
+            p->values = 0;
+        }
+        page = next;
     }
 
-    /* Copy payload to output */
-    size_t copy_len = pkt_size;
-    if (copy_len > *out_len) copy_len = *out_len;
-    if (copy_len > 0) memcpy(out_payload, tail, copy_len);
-    *out_len = pkt_size;
+    return full ? SDI12_ERR_BUFFER_OVERFLOW : SDI12_OK;
+}
 
-    /* Store total packet size for timing layer access */
-    ctx->resp_len = 3 + 1 + tail_len;
+sdi12_err_t sdi12_master_collect_hv(sdi12_master_ctx_t *ctx,
+                                     char addr,
+                                     const sdi12_meas_response_t *meas,
+                                     bool crc,
+                                     sdi12_hv_arena_t *arena,
+                                     sdi12_hv_page_fn on_page,
+                                     void *user_data,
+                                     sdi12_hv_stats_t *stats)
+{
+    if (!ctx || !meas || !arena || !arena->buf || !arena->pages)
+        return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
 
-    return SDI12_OK;
+    hv_run_t r;
+    memset(&r, 0, sizeof(r));
+    r.ctx = ctx;
+    r.arena = arena;
+    r.addr = addr;
+    r.binary = meas->type == SDI12_MEAS_HIGHVOL_BINARY;
+    r.crc = crc && !r.binary;
+
+    /* The caller has just had the atttnnn reply: the bus is awake */
+    r.clk.awake = true;
+    if (ctx->cb.millis) r.clk.start_ms = ctx->cb.millis(ctx->cb.user_data);
+
+    arena->used = 0;
+    arena->page_count = 0;
+    arena->value_count = 0;
+
+    sdi12_err_t err = SDI12_OK;
+    if (meas->value_count > 0) {
+        err = hv_walk(&r, false, meas->value_count, on_page, user_data);
+        for (uint8_t round = 0;
+             err == SDI12_OK && round < SDI12_HV_RETRY_ROUNDS && hv_next_failed(arena, 0) >= 0;
+             round++) {
+            err = hv_walk(&r, true, meas->value_count, on_page, user_data);
+        }
+    }
+
+    uint16_t failed = 0;
+    sdi12_err_t page_err = SDI12_OK;
+    for (uint16_t i = 0; i < arena->page_count; i++) {
+        if (arena->pages[i].status == SDI12_OK) continue;
+        failed++;
+        page_err = arena->pages[i].status;
+    }
+
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+        stats->pages = (uint16_t)(arena->page_count - failed);
+        stats->retried = r.retried;
+        stats->failed = failed;
+        stats->breaks = r.breaks;
+        stats->wall_ms = clock_now(ctx, &r.clk);
+        stats->bus_ms = r.clk.bus_ms;
+        if (stats->wall_ms > 0) {
+            stats->pages_per_sec = (uint32_t)((uint64_t)stats->pages * 1000u / stats->wall_ms);
+        }
+    }
+
+    if (err != SDI12_OK) return err;
+    if (page_err != SDI12_OK) return page_err;
+    return arena->value_count >= meas->value_count ? SDI12_OK : SDI12_ERR_NO_DATA;
 }
 
-size_t sdi12_bintype_size(sdi12_bintype_t type)
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  High-Volume ASCII Values                                                 */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Walk the HA pages in order with the next command one page ahead, parsing
+ * each page from resp_buf straight to values + *count. A failed page is
+ * asked again at once, after letting the page already requested behind it
+ * go by, so the values stay in measurement order.
+ */
+static sdi12_err_t ha_walk(hv_run_t *r, uint16_t expected, sdi12_value_t *values,
+                           uint16_t max_values, uint16_t *count, uint16_t *pages)
 {
-    switch (type) {
-    case SDI12_BINTYPE_INT8:
-    case SDI12_BINTYPE_UINT8:   return 1;
-    case SDI12_BINTYPE_INT16:
-    case SDI12_BINTYPE_UINT16:  return 2;
-    case SDI12_BINTYPE_INT32:
-    case SDI12_BINTYPE_UINT32:
-    case SDI12_BINTYPE_FLOAT32: return 4;
-    case SDI12_BINTYPE_INT64:
-    case SDI12_BINTYPE_UINT64:
-    case SDI12_BINTYPE_FLOAT64: return 8;
-    default:                    return 0;
+    uint16_t page = 0;
+    uint8_t misses = 0;
+    hv_request(r, 0);
+
+    for (;;) {
+        uint16_t signs = 0;
+        sdi12_err_t err = hv_receive(r, page, &signs);
+        if (err == SDI12_OK && signs == 0) return SDI12_OK;   /* past the data */
+
+        uint32_t after = (uint32_t)*count + signs;
+        bool ahead = err == SDI12_OK && after < expected && after < max_values &&
+                     page + 1u < SDI12_HV_MAX_PAGES;
+        if (ahead) hv_request(r, (uint16_t)(page + 1));
+
+        /* Page k while page k+1 is on the wire */
+        if (err == SDI12_OK) {
+            uint16_t room = (uint16_t)(max_values - *count);
+            uint8_t got = 0;
+            err = parse_line(r->ctx->resp_buf, r->text_len, values + *count, NULL, NULL,
+                             room < UINT8_MAX ? (uint8_t)room : UINT8_MAX, &got,
+                             r->crc, NULL);
+            if (err == SDI12_OK) {
+                *count = (uint16_t)(*count + got);
+                (*pages)++;
+                misses = 0;
+                if (ahead) {
+                    page++;
+                    continue;
+                }
+                return *count < expected && after >= max_values
+                    ? SDI12_ERR_BUFFER_OVERFLOW : SDI12_OK;
+            }
+        }
+
+        if (ahead) {
+            uint16_t skip;   /* page k+1 is re-requested after page k */
+            hv_receive(r, (uint16_t)(page + 1), &skip);
+        }
+        if (++misses > SDI12_LINK_RETRIES) return err;
+        r->retried++;
+        hv_pace(r);
+        hv_request(r, page);
+    }
+}
+
+sdi12_err_t sdi12_master_collect_ha_values(sdi12_master_ctx_t *ctx,
+                                            char addr,
+                                            const sdi12_meas_response_t *meas,
+                                            bool crc,
+                                            sdi12_value_t *values,
+                                            uint16_t max_values,
+                                            uint16_t *count,
+                                            sdi12_hv_stats_t *stats)
+{
+    if (!ctx || !meas || !values || !count) return SDI12_ERR_INVALID_COMMAND;
+    if (meas->type == SDI12_MEAS_HIGHVOL_BINARY) return SDI12_ERR_INVALID_COMMAND;
+    if (!sdi12_valid_address(addr)) return SDI12_ERR_INVALID_ADDRESS;
+
+    hv_run_t r;
+    memset(&r, 0, sizeof(r));
+    r.ctx = ctx;
+    r.addr = addr;
+    r.crc = crc;
+
+    /* The caller has just had the atttnnn reply: the bus is awake */
+    r.clk.awake = true;
+    if (ctx->cb.millis) r.clk.start_ms = ctx->cb.millis(ctx->cb.user_data);
+
+    *count = 0;
+    uint16_t pages = 0;
+    sdi12_err_t err = SDI12_OK;
+    if (meas->value_count > 0 && max_values > 0) {
+        err = ha_walk(&r, meas->value_count, values, max_values, count, &pages);
+    } else if (meas->value_count > 0) {
+        err = SDI12_ERR_BUFFER_OVERFLOW;
+    }
+
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+        stats->pages = pages;
+        stats->retried = r.retried;
+        stats->failed = err != SDI12_OK && err != SDI12_ERR_BUFFER_OVERFLOW ? 1 : 0;
+        stats->breaks = r.breaks;
+        stats->wall_ms = clock_now(ctx, &r.clk);
+        stats->bus_ms = r.clk.bus_ms;
+        if (stats->wall_ms > 0) {
+            stats->pages_per_sec = (uint32_t)((uint64_t)stats->pages * 1000u / stats->wall_ms);
+        }
     }
+
+    if (err != SDI12_OK) return err;
+    return *count >= meas->value_count ? SDI12_OK : SDI12_ERR_NO_DATA;
 }
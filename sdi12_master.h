@@ -6,14 +6,19 @@
  * sensors on the bus. All bus I/O goes through user-provided callbacks.
  *
  * Features:
- *   - Send break signal
+ *   - Send break signal (skipped while the bus is provably awake)
  *   - Query / change sensor addresses
  *   - Request identification
  *   - Start measurements (M, MC, C, CC, V, R/RC)
  *   - Parse measurement responses (atttn / atttnn / atttnnn)
  *   - Parse data responses (aD0–aD9) with value extraction
+ *   - Receive framer: end-of-frame on CR/LF, length or inter-character gap
  *   - CRC verification on C-variant responses
  *   - Transparent command passthrough for extended commands (X)
+ *   - Non-blocking transaction engine (submit / poll / on_rx)
+ *   - Whole-bus concurrent survey (aC! to every sensor, deadline-ordered D)
+ *   - Periodic multi-rate scheduler with bus-capacity admission control
+ *   - Sensor metadata cache with a serializable blob for warm starts
  *
  * Usage Pattern:
  *   1. sdi12_master_init()
@@ -21,6 +26,11 @@
  *   3. sdi12_master_request_*()        — build command string
  *   4. User sends command + waits for response via platform I/O
  *   5. sdi12_master_parse_*()          — decode sensor response
+ *
+ * Event-driven alternative (no blocking in recv/delay):
+ *   1. sdi12_master_submit()           — queue a caller-owned transaction
+ *   2. sdi12_master_on_rx()            — feed bytes from the UART RX path
+ *   3. sdi12_master_poll()             — advance timers, send, complete
  */
 #ifndef SDI12_MASTER_H
 #define SDI12_MASTER_H
@@ -45,6 +55,13 @@ typedef void (*sdi12_master_send_fn)(const char *data, size_t len, void *user_da
  * Receive bytes from the SDI-12 bus.
  * Implementation should block/poll for up to `timeout_ms` milliseconds.
  * Returns number of bytes read into `buf`, 0 on timeout.
+ *
+ * Responses are read a byte at a time (buflen 1) through the receive
+ * framer, so return as soon as `buflen` bytes have arrived. By default
+ * every byte may take as long as the rest of the longest expected reply
+ * (line mode), so a recv with delivery latency works unchanged. A recv
+ * that hands over each byte as it comes off the wire can end replies
+ * sooner with sdi12_master_set_char_gap().
  */
 typedef size_t (*sdi12_master_recv_fn)(char *buf, size_t buflen,
                                         uint32_t timeout_ms, void *user_data);
@@ -67,6 +84,13 @@ typedef void (*sdi12_master_send_break_fn)(void *user_data);
  */
 typedef void (*sdi12_master_delay_fn)(uint32_t ms, void *user_data);
 
+/**
+ * Read a free-running millisecond clock (optional, may wrap).
+ * Without it, elapsed time is estimated from delays, timeouts and the
+ * 1200-baud transmit time of commands and responses.
+ */
+typedef uint32_t (*sdi12_master_millis_fn)(void *user_data);
+
 /** Master callback collection. */
 typedef struct {
     sdi12_master_send_fn        send;
@@ -74,9 +98,170 @@ typedef struct {
     sdi12_master_set_dir_fn     set_direction;
     sdi12_master_send_break_fn  send_break;
     sdi12_master_delay_fn       delay;
+    sdi12_master_millis_fn      millis;        /**< Optional (NULL). */
     void                       *user_data;
 } sdi12_master_callbacks_t;
 
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Receive Framer                                                           */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** State of a frame being received. */
+typedef enum {
+    SDI12_FRAME_PENDING = 0, /**< Still arriving. */
+    SDI12_FRAME_COMPLETE,    /**< Ended with CR/LF or reached expect_len. */
+    SDI12_FRAME_TRUNCATED,   /**< Sensor went quiet mid-frame (gap > 1.66 ms). */
+    SDI12_FRAME_GARBAGE,     /**< Wrong address, non-printable byte or too long. */
+    SDI12_FRAME_TIMEOUT      /**< Nothing within SDI12_RESPONSE_TIMEOUT_MS. */
+} sdi12_frame_status_t;
+
+/**
+ * Length bounds of a response frame in characters, address and CR/LF
+ * (and CRC, where requested) included. At 1200 baud every character is
+ * SDI12_CHAR_US on the wire, so the bounds also bound the reply time.
+ */
+typedef struct {
+    uint8_t min;  /**< Shortest valid reply (3 for "a<CR><LF>"). */
+    uint8_t max;  /**< Longest valid reply. */
+} sdi12_resp_len_t;
+
+/**
+ * Byte-level response framer, fed bytes with their arrival time (e.g.
+ * from a UART RX interrupt). Decides end-of-frame as soon as the sensor
+ * stops talking instead of waiting out a worst-case timeout. The frame is
+ * NUL-terminated in `buf`.
+ */
+typedef struct {
+    char                 *buf;        /**< Caller-provided frame buffer. */
+    size_t                cap;        /**< Size of buf. */
+    size_t                len;        /**< Bytes in the frame so far. */
+    size_t                expect_len; /**< Exact length incl. CR/LF, 0 = variable. */
+    size_t                min_len;    /**< Shorter frames are TRUNCATED, 0 = no bound. */
+    size_t                max_len;    /**< Longer frames are GARBAGE, 0 = buffer size. */
+    char                  addr;       /**< Required first character, '\0' = any. */
+    uint32_t              start_us;   /**< End of the command (framer start). */
+    uint32_t              last_us;    /**< Arrival of the latest byte. */
+    sdi12_frame_status_t  status;
+} sdi12_framer_t;
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Non-blocking Transactions                                                */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+struct sdi12_txn;
+
+/**
+ * Completion callback for a queued transaction. Called from
+ * sdi12_master_poll(); the transaction may be resubmitted from here.
+ */
+typedef void (*sdi12_txn_done_fn)(struct sdi12_txn *txn, void *user_data);
+
+/** What a transaction does. */
+typedef enum {
+    SDI12_TXN_COMMAND = 0, /**< Send `cmd`, complete on the response line. */
+    SDI12_TXN_MEASURE      /**< aM!/aC!/aV!, wait ttt, collect all D pages. */
+} sdi12_txn_kind_t;
+
+/**
+ * Caller-owned transaction, linked into the master's queue by
+ * sdi12_master_submit(). Must stay valid until on_done has been called.
+ */
+typedef struct sdi12_txn {
+    /* Request — filled in by the caller */
+    sdi12_txn_kind_t      kind;
+    char                  addr;
+    sdi12_meas_type_t     type;     /**< MEASURE: STANDARD, CONCURRENT or VERIFICATION. */
+    uint8_t               group;    /**< MEASURE: group 0–9. */
+    bool                  crc;      /**< MEASURE: request and verify CRC. */
+    char                  cmd[SDI12_CMD_MAX_CHARS + 1]; /**< COMMAND: e.g. "0I!". */
+    sdi12_txn_done_fn     on_done;
+    void                 *user_data;
+
+    /* Result — valid in on_done */
+    sdi12_err_t           result;
+    sdi12_meas_response_t meas;     /**< MEASURE: parsed atttn reply. */
+    sdi12_data_response_t data;     /**< MEASURE: values from all pages. */
+    char                  resp[SDI12_RESP_MAX_CHARS + 4]; /**< COMMAND: response line. */
+    size_t                resp_len;
+
+    /* Engine state — private */
+    uint8_t               state;
+    uint8_t               next_state;
+    uint8_t               page;
+    uint8_t               max_len;  /**< Longest valid reply to the pending command. */
+    uint32_t              deadline_ms;
+    struct sdi12_txn     *next;
+} sdi12_txn_t;
+
+/** sdi12_master_poll() return value when no transaction is queued. */
+#define SDI12_POLL_IDLE UINT32_MAX
+
+/**
+ * Receive ring between sdi12_master_on_rx() and sdi12_master_poll(), in
+ * bytes. A power of two up to 128, so the indices are single bytes.
+ */
+#define SDI12_RX_RING_SIZE 128
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Survey Types                                                             */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** One sensor in a sdi12_master_survey(). */
+typedef struct {
+    /* Request — filled in by the caller */
+    char                  addr;
+    uint8_t               group;     /**< aC<group>!, 0–9. */
+    bool                  crc;       /**< aCC! and CRC-checked D pages. */
+
+    /* Result */
+    sdi12_err_t           result;
+    sdi12_meas_response_t meas;      /**< Parsed atttnn reply. */
+    sdi12_data_response_t data;      /**< Values from all D pages. */
+    uint32_t              ready_ms;  /**< Data-ready deadline, from survey start. */
+    uint32_t              done_ms;   /**< Last page received, from survey start. */
+} sdi12_survey_entry_t;
+
+/** Survey timing summary. */
+typedef struct {
+    uint32_t wall_ms;        /**< Survey start to last page. */
+    uint32_t bus_ms;         /**< Line time: breaks, commands and responses. */
+    uint32_t sequential_ms;  /**< bus_ms + every ttt — a one-at-a-time aM! loop. */
+    uint8_t  utilization;    /**< bus_ms / wall_ms, percent. */
+    uint8_t  ok;             /**< Entries that completed with SDI12_OK. */
+} sdi12_survey_stats_t;
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Link Statistics Types                                                    */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Retries per break, as required by the spec (at least three). */
+#define SDI12_LINK_RETRIES        3
+
+/** Successful replies needed before a link's timeout is tightened. */
+#define SDI12_LINK_LEARN          4
+
+/** Smoothed failure rate above which a link gets a second retry round. */
+#define SDI12_LINK_FLAKY_PERMILLE 200
+
+/**
+ * Per-address link statistics, learned by sdi12_master_transact() once a
+ * table has been attached with sdi12_master_set_links(). Counters are
+ * plain totals for tuning; clear them at will.
+ */
+typedef struct {
+    char     addr;            /**< Address, '\0' = free slot. */
+    uint32_t transactions;    /**< Transactions to this address. */
+    uint32_t ok;              /**< Attempts that got a well-formed reply. */
+    uint32_t retries;         /**< Attempts after the first. */
+    uint32_t timeouts;        /**< Attempts with no reply. */
+    uint32_t bad_frames;      /**< Attempts with a garbled or truncated reply. */
+    uint32_t failures;        /**< Transactions that ran out of retries. */
+    uint32_t rebreaks;        /**< Breaks sent between retries. */
+    uint16_t latency_ms;      /**< Smoothed turnaround (millis callback only). */
+    uint16_t latency_max_ms;  /**< Worst turnaround seen. */
+    uint16_t fail_permille;   /**< Smoothed attempt failure rate. */
+} sdi12_link_t;
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Master Context                                                           */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -86,8 +271,235 @@ typedef struct {
     char                     cmd_buf[SDI12_CMD_MAX_CHARS + 4];  /**< Outgoing command buffer */
     char                     resp_buf[SDI12_RESP_MAX_CHARS + 4]; /**< Incoming response buffer */
     size_t                   resp_len;                          /**< Bytes in response buffer */
+
+    /* Non-blocking engine */
+    sdi12_txn_t             *txn_head;     /**< Active transaction (queue head). */
+    sdi12_txn_t             *txn_tail;
+    uint32_t                 now_ms;       /**< Clock from the latest sdi12_master_poll(). */
+
+    /* Receive ring: sdi12_master_on_rx() writes rx_head, poll() rx_tail */
+    char                     rx_ring[SDI12_RX_RING_SIZE];
+    volatile uint8_t         rx_head;
+    volatile uint8_t         rx_tail;
+    volatile bool            rx_overrun;   /**< Bytes lost to a full ring. */
+    volatile uint32_t        rx_last_ms;   /**< on_rx() time of the newest bytes. */
+
+    /* Bus activity tracking (break elision) */
+    uint32_t                 last_bus_ms;  /**< Last send/receive on the bus. */
+    bool                     bus_awake;    /**< A break has been sent; last_bus_ms is valid. */
+    uint32_t                 breaks_elided; /**< Breaks skipped by sdi12_master_send_break(). */
+
+    /* Retries and per-address statistics */
+    sdi12_link_t            *links;        /**< Caller's link table, NULL = no retries. */
+    size_t                   link_count;
+    uint32_t                 rx_first_ms;  /**< millis() when the latest reply began. */
+
+    /* Reply framing */
+    uint32_t                 char_gap_ms;  /**< Silence that ends a reply, 0 = line mode (default). */
 } sdi12_master_ctx_t;
 
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Scheduler Types                                                          */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+struct sdi12_sched_job;
+
+/** Called from sdi12_sched_poll() when a job run completes. */
+typedef void (*sdi12_sched_done_fn)(struct sdi12_sched_job *job, void *user_data);
+
+/**
+ * Load (per mille of bus time) above which a schedule is admitted but has
+ * little slack left for retries and unscheduled commands.
+ */
+#define SDI12_SCHED_WARN_PERMILLE 700
+
+/** A periodic measurement for sdi12_sched_poll(). Caller-owned. */
+typedef struct sdi12_sched_job {
+    /* Configuration — filled in by the caller */
+    char                  addr;
+    sdi12_meas_type_t     type;       /**< STANDARD (aM!) or CONCURRENT (aC!). */
+    uint8_t               group;      /**< 0–9. */
+    bool                  crc;
+    uint32_t              period_ms;  /**< Release interval; also the deadline. */
+    uint16_t              ttt_s;      /**< Expected ttt (aIM!/aIC! or datasheet). */
+    uint8_t               values;     /**< Expected value count. */
+    sdi12_sched_done_fn   on_done;    /**< Optional. */
+    void                 *user_data;
+
+    /* Result — valid in on_done */
+    sdi12_err_t           result;
+    sdi12_data_response_t data;
+
+    /* Statistics */
+    uint32_t              cost_ms;    /**< Estimated bus occupancy per run. */
+    uint32_t              runs;
+    uint32_t              overruns;   /**< Releases dropped because the job was behind. */
+    uint32_t              max_late_ms; /**< Worst completion past the deadline. */
+
+    /* Scheduler state — private */
+    uint32_t              release_ms;
+    uint32_t              ready_ms;
+    uint8_t               expect;     /**< Value count from the latest atttn. */
+    uint8_t               phase;
+} sdi12_sched_job_t;
+
+/** Scheduler instance. */
+typedef struct {
+    sdi12_master_ctx_t *ctx;
+    sdi12_sched_job_t  *jobs;
+    uint8_t             count;
+    uint16_t            load_permille;  /**< Sum of cost_ms / period_ms. */
+} sdi12_sched_t;
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Metadata Cache Types                                                     */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Parameters kept per cached sensor, all groups together. */
+#define SDI12_META_MAX_PARAMS SDI12_MAX_PARAMS
+
+/** aI! reply after the address: version, vendor, model, firmware, serial. */
+#define SDI12_META_IDENT_LEN (SDI12_ID_VERSION_LEN + SDI12_ID_VENDOR_LEN + \
+                              SDI12_ID_MODEL_LEN + SDI12_ID_FWVER_LEN + \
+                              SDI12_ID_SERIAL_MAXLEN)
+
+/** Everything the identify commands report about one sensor. */
+typedef struct {
+    char               addr;      /**< Address, '\0' = free slot. */
+    char               ident[SDI12_META_IDENT_LEN + 1]; /**< Cache key with addr. */
+    uint8_t            m_count[SDI12_MAX_MEAS_GROUPS];  /**< aIM!, aIM1!–aIM9!. */
+    uint8_t            c_count[SDI12_MAX_MEAS_GROUPS];  /**< aIC!, aIC1!–aIC9!. */
+    uint8_t            param_count; /**< Entries used in params. */
+    sdi12_param_meta_t params[SDI12_META_MAX_PARAMS];   /**< Group 0 first, then 1, … */
+} sdi12_meta_entry_t;
+
+/** Caller-owned table of cached sensors. */
+typedef struct {
+    sdi12_meta_entry_t *entries;
+    size_t              count;
+} sdi12_meta_cache_t;
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Compact Data Container                                                   */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Bytes of quality bitmap for `cap` values. */
+#define SDI12_SOA_QUALITY_BYTES(cap) (((cap) + 7u) / 8u)
+
+/**
+ * Structure-of-arrays measurement results over caller-owned arrays of
+ * any capacity. 3 values cost 3 floats, 3 bytes and 1 bitmap byte, where
+ * sdi12_data_response_t always costs SDI12_MAX_VALUES entries. Collection
+ * appends, so one container can gather many sensors back to back.
+ */
+typedef struct {
+    float    *values;    /**< capacity entries. */
+    uint8_t  *decimals;  /**< capacity entries, or NULL if not wanted. */
+    uint8_t  *quality;   /**< SDI12_SOA_QUALITY_BYTES(capacity), or NULL.
+                              Bit i%8 of byte i/8: value i came on a page
+                              whose CRC checked out. */
+    uint16_t  capacity;
+    uint16_t  count;     /**< Values stored so far. */
+} sdi12_data_soa_t;
+
+/** True if value i of `d` arrived on a CRC-verified page. */
+static inline bool sdi12_soa_verified(const sdi12_data_soa_t *d, uint16_t i)
+{
+    return d->quality && i < d->count && (d->quality[i / 8u] >> (i % 8u)) & 1u;
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Response View Types                                                      */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Read-only characters inside the master's receive buffer. A view stays
+ * valid until the next command on the same context; copy what must
+ * outlive it. The text is not null-terminated.
+ */
+typedef struct {
+    const char *ptr;
+    size_t      len;
+} sdi12_span_t;
+
+/** aI! reply split in place: "a14VENDOR__MODEL_FW_SERIAL". */
+typedef struct {
+    char         address;
+    sdi12_span_t version;   /**< 2 chars, e.g. "14". */
+    sdi12_span_t vendor;    /**< 8 chars, padding kept. */
+    sdi12_span_t model;     /**< 6 chars. */
+    sdi12_span_t firmware;  /**< 3 chars. */
+    sdi12_span_t serial;    /**< 0–13 chars. */
+} sdi12_ident_view_t;
+
+/** One data value exactly as the sensor sent it. */
+typedef struct {
+    sdi12_span_t text;      /**< Sign and digits, e.g. "+0.100". */
+    uint8_t      decimals;  /**< Digits after the point (3 for "+0.100"). */
+    uint16_t     index;     /**< Position in the measurement, from 0. */
+} sdi12_value_text_t;
+
+/**
+ * Receives each value of sdi12_master_collect_text(). The text is a view
+ * into the receive buffer, valid only during the call.
+ */
+typedef void (*sdi12_value_emit_fn)(char addr, const sdi12_value_text_t *value,
+                                    void *user_data);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  High-Volume Collection Types                                             */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Data pages of an aHA!/aHB! result: D0–D999. */
+#define SDI12_HV_MAX_PAGES     1000
+
+/** Passes over the failed pages once the first walk is done. */
+#define SDI12_HV_RETRY_ROUNDS  2
+
+/** Where one page of a sdi12_master_collect_hv() landed. */
+typedef struct {
+    uint32_t        offset;  /**< Payload start in the arena's buf. */
+    uint16_t        len;     /**< Value text after the address, CRC stripped
+                                  (HA), or raw little-endian payload (HB). */
+    uint16_t        values;  /**< Values on the page. */
+    sdi12_bintype_t type;    /**< HB payload type; SDI12_BINTYPE_INVALID for HA. */
+    sdi12_err_t     status;  /**< SDI12_OK once received intact. */
+} sdi12_hv_page_t;
+
+/**
+ * Caller memory for a high-volume result: page payloads are appended to
+ * `buf` and indexed by page number in `pages`. A retried page is appended
+ * where it lands, so payloads are in arrival order, not page order.
+ */
+typedef struct {
+    uint8_t         *buf;
+    size_t           cap;
+    size_t           used;        /**< Bytes of buf filled. */
+    sdi12_hv_page_t *pages;       /**< max_pages entries. */
+    uint16_t         max_pages;
+    uint16_t         page_count;  /**< Data pages 0..page_count-1 were requested. */
+    uint16_t         value_count; /**< Values on intact pages. */
+} sdi12_hv_arena_t;
+
+/**
+ * Called for each intact page while the next page's command is already
+ * on the bus, so decoding overlaps the transfer. Keep it shorter than a
+ * sensor's turnaround (~8–15 ms) unless the recv callback buffers.
+ */
+typedef void (*sdi12_hv_page_fn)(char addr, uint16_t page,
+                                 const sdi12_hv_arena_t *arena, void *user_data);
+
+/** High-volume collection summary. */
+typedef struct {
+    uint16_t pages;          /**< Data pages received intact. */
+    uint16_t retried;        /**< Page requests repeated after a failure. */
+    uint16_t failed;         /**< Pages still bad after every retry round. */
+    uint16_t breaks;         /**< Breaks sent during the collection. */
+    uint32_t wall_ms;        /**< First command to last reply. */
+    uint32_t bus_ms;         /**< Line time: breaks, commands and replies. */
+    uint32_t pages_per_sec;  /**< pages * 1000 / wall_ms. */
+} sdi12_hv_stats_t;
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Initialization                                                           */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -102,19 +514,57 @@ typedef struct {
 sdi12_err_t sdi12_master_init(sdi12_master_ctx_t *ctx,
                                const sdi12_master_callbacks_t *callbacks);
 
+/**
+ * Set how long the master waits for the next byte of a reply before
+ * taking it as ended. The default, 0, is line mode: a reply ends on CR/LF
+ * or its longest expected length, and each byte may take as long as the
+ * rest of that longest reply plus SDI12_RESPONSE_TIMEOUT_MS. That suits
+ * any recv, but a reply that stops short is only noticed after the wait.
+ *
+ * A recv that hands over each byte as it comes off the wire can use
+ * SDI12_CHAR_GAP_MS instead, so a cut-off reply fails at once. Add the
+ * delivery latency of the serial path on top, e.g. the 16 ms latency
+ * timer of a USB-serial adapter; too short a gap truncates replies.
+ *
+ * @param ctx     Master context, after sdi12_master_init().
+ * @param gap_ms  Inter-character timeout in ms, or 0 for line mode.
+ */
+void sdi12_master_set_char_gap(sdi12_master_ctx_t *ctx, uint32_t gap_ms);
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Bus Operations                                                           */
 /* ────────────────────────────────────────────────────────────────────────── */
 
 /**
- * Send a break signal to wake all sensors on the bus.
+ * Send a break signal to wake all sensors on the bus, if needed.
  * Holds the line for ≥ 12ms break + 8.33ms marking.
+ *
+ * With a millis callback, the master tracks the last bus activity and
+ * skips the break (counting breaks_elided) while the sensors are still
+ * awake — within SDI12_MARKING_TIMEOUT_MS of the last command or
+ * response. Without one, every call sends a break.
  */
 sdi12_err_t sdi12_master_send_break(sdi12_master_ctx_t *ctx);
 
+/**
+ * Always send a break, e.g. to abort a measurement in progress or to
+ * resynchronise after a garbled exchange.
+ */
+sdi12_err_t sdi12_master_force_break(sdi12_master_ctx_t *ctx);
+
 /**
  * Send a raw command string and receive the response.
  *
+ * With a link table attached (sdi12_master_set_links()), a missing or
+ * garbled reply is retried per the spec: each retry waits at least
+ * SDI12_RETRY_MIN_MS after the previous command, up to
+ * SDI12_LINK_RETRIES retries follow one break, and a new break is sent
+ * first if the line has idled for SDI12_MARKING_TIMEOUT_MS. Flaky links
+ * (fail_permille ≥ SDI12_LINK_FLAKY_PERMILLE) get a second round after a
+ * fresh break. A link with SDI12_LINK_LEARN good replies and a millis
+ * callback waits only its worst observed turnaround plus the
+ * inter-character gap, capped at timeout_ms.
+ *
  * @param ctx         Master context.
  * @param cmd         Command to send (e.g., "0M!").
  * @param timeout_ms  Maximum time to wait for response.
@@ -124,6 +574,28 @@ sdi12_err_t sdi12_master_transact(sdi12_master_ctx_t *ctx,
                                    const char *cmd,
                                    uint32_t timeout_ms);
 
+/**
+ * Attach a link table: enables retries in sdi12_master_transact() and
+ * per-address statistics. Slots are claimed by address on first use;
+ * addresses beyond the table's size, and "?!", run without retries.
+ *
+ * @param ctx    Master context.
+ * @param links  Caller-owned table (cleared here), or NULL to detach.
+ * @param count  Number of slots.
+ * @return SDI12_OK.
+ */
+sdi12_err_t sdi12_master_set_links(sdi12_master_ctx_t *ctx,
+                                    sdi12_link_t *links, size_t count);
+
+/**
+ * Statistics for one address.
+ *
+ * @param ctx   Master context.
+ * @param addr  Sensor address.
+ * @return The address's link entry, NULL if it has none.
+ */
+const sdi12_link_t *sdi12_master_link(const sdi12_master_ctx_t *ctx, char addr);
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Address Commands                                                         */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -162,6 +634,28 @@ sdi12_err_t sdi12_master_acknowledge(sdi12_master_ctx_t *ctx,
 sdi12_err_t sdi12_master_change_address(sdi12_master_ctx_t *ctx,
                                          char old_addr, char new_addr);
 
+/**
+ * Discover the sensors on the bus.
+ *
+ * Starts with "?!": silence means an empty bus and the scan ends after
+ * one timeout. A clean reply names a sensor; unless `exhaustive`, that
+ * address is confirmed with "a!" and the scan ends — use this only where
+ * the bus is known to hold at most one sensor, since overlapping replies
+ * usually, but not always, garble. Otherwise every address is probed with
+ * "a!". Each probe gets exactly SDI12_RESPONSE_TIMEOUT_MS of silence —
+ * the spec's response window — and the next address is probed as soon as
+ * it closes. Probes keep the line busy, so one break covers the scan. A
+ * garbled reply is retried, SDI12_RETRY_MIN_MS apart, up to
+ * SDI12_LINK_RETRIES times.
+ *
+ * @param ctx         Master context.
+ * @param exhaustive  Probe all 62 addresses even after a clean "?!".
+ * @param found       [out] Bit sdi12_address_index(a) set for each sensor.
+ * @return SDI12_OK, or SDI12_ERR_INVALID_COMMAND for NULL arguments.
+ */
+sdi12_err_t sdi12_master_scan(sdi12_master_ctx_t *ctx, bool exhaustive,
+                               uint64_t *found);
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Identification                                                           */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -178,6 +672,18 @@ sdi12_err_t sdi12_master_change_address(sdi12_master_ctx_t *ctx,
 sdi12_err_t sdi12_master_identify(sdi12_master_ctx_t *ctx,
                                    char addr, sdi12_ident_t *ident);
 
+/**
+ * Like sdi12_master_identify(), without copying: each field is a view into
+ * the receive buffer, valid until the next command.
+ *
+ * @param ctx   Master context.
+ * @param addr  Sensor address.
+ * @param view  [out] Field views.
+ * @return SDI12_OK on success, SDI12_ERR_INVALID_COMMAND for a short reply.
+ */
+sdi12_err_t sdi12_master_identify_view(sdi12_master_ctx_t *ctx,
+                                       char addr, sdi12_ident_view_t *view);
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Measurement Commands                                                     */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -221,14 +727,137 @@ sdi12_err_t sdi12_master_wait_service_request(sdi12_master_ctx_t *ctx,
  * @param ctx       Master context.
  * @param addr      Sensor address.
  * @param page      Data page 0–9.
- * @param crc       Whether CRC was requested (verifies CRC if true).
+ * @param crc       Whether CRC was requested. The CRC over address and
+ *                  values is checked during the same scan that parses them
+ *                  and reported in resp->crc_valid.
  * @param resp      [out] Parsed data response with values.
- * @return SDI12_OK on success, SDI12_ERR_CRC on CRC failure.
+ * @return SDI12_OK on success, SDI12_ERR_CRC_MISMATCH on CRC failure.
  */
 sdi12_err_t sdi12_master_get_data(sdi12_master_ctx_t *ctx,
                                    char addr, uint8_t page, bool crc,
                                    sdi12_data_response_t *resp);
 
+/**
+ * Like sdi12_master_get_data(), but the values come back as exact decimals.
+ * No float conversion: "+1234.567" arrives as {1234567, 3}.
+ *
+ * @param ctx       Master context.
+ * @param addr      Sensor address.
+ * @param page      Data page 0–9.
+ * @param crc       Whether CRC was requested (verified while parsing).
+ * @param values    [out] Parsed values.
+ * @param max_values Size of values array.
+ * @param count     [out] Number of values parsed.
+ * @return SDI12_OK on success, SDI12_ERR_CRC_MISMATCH on CRC failure.
+ */
+sdi12_err_t sdi12_master_get_data_decimal(sdi12_master_ctx_t *ctx,
+                                          char addr, uint8_t page, bool crc,
+                                          sdi12_decimal_t *values,
+                                          uint8_t max_values,
+                                          uint8_t *count);
+
+/**
+ * Like sdi12_master_get_data(), but each value comes back as a view of its
+ * text as sent ("+0.100" stays "+0.100"), valid until the next command.
+ * Nothing is copied or converted; the CRC is still verified while scanning.
+ *
+ * @param ctx       Master context.
+ * @param addr      Sensor address.
+ * @param page      Data page 0–9.
+ * @param crc       Whether CRC was requested.
+ * @param values    [out] One view per value, sign included.
+ * @param max_values Size of values array.
+ * @param count     [out] Number of values.
+ * @return SDI12_OK on success, SDI12_ERR_CRC_MISMATCH on CRC failure.
+ */
+sdi12_err_t sdi12_master_get_data_view(sdi12_master_ctx_t *ctx,
+                                       char addr, uint8_t page, bool crc,
+                                       sdi12_span_t *values,
+                                       uint8_t max_values,
+                                       uint8_t *count);
+
+/**
+ * Collect every value of a finished measurement in one call.
+ *
+ * Sends aD0!, aD1!, ... and stops as soon as `meas->value_count` values
+ * have arrived, so no D command is sent that would return only the
+ * address. With `crc`, each page's CRC is verified (crc_valid is set).
+ *
+ * @param ctx   Master context.
+ * @param addr  Sensor address.
+ * @param meas  Parsed atttn reply of the measurement (value_count).
+ * @param crc   Whether CRC was requested with the measurement.
+ * @param out   [out] All values, in order.
+ * @return SDI12_OK when all values arrived; SDI12_ERR_NO_DATA if the
+ *         sensor ran short (out holds what arrived), SDI12_ERR_TIMEOUT,
+ *         SDI12_ERR_CRC_MISMATCH, or SDI12_ERR_BUFFER_OVERFLOW if
+ *         value_count exceeds SDI12_MAX_VALUES.
+ */
+sdi12_err_t sdi12_master_collect(sdi12_master_ctx_t *ctx,
+                                  char addr,
+                                  const sdi12_meas_response_t *meas,
+                                  bool crc,
+                                  sdi12_data_response_t *out);
+
+/**
+ * Text pass-through version of sdi12_master_collect().
+ *
+ * Walks the D pages the same way but never converts a value: each one is
+ * handed to `emit` as the sensor's own text ("+0.100", trailing zeros
+ * kept) with its decimal count. With `crc`, a page is emitted only after
+ * its CRC has checked out. There is no value limit, so counts above
+ * SDI12_MAX_VALUES are fine.
+ *
+ * @param ctx       Master context.
+ * @param addr      Sensor address.
+ * @param meas      Parsed atttn reply of the measurement (value_count).
+ * @param crc       Whether CRC was requested with the measurement.
+ * @param emit      Called once per value, in order.
+ * @param user_data Passed to emit.
+ * @param emitted   [out] Values emitted (optional).
+ * @return SDI12_OK when all values arrived; SDI12_ERR_NO_DATA if the
+ *         sensor ran short, SDI12_ERR_TIMEOUT or SDI12_ERR_CRC_MISMATCH.
+ */
+sdi12_err_t sdi12_master_collect_text(sdi12_master_ctx_t *ctx,
+                                       char addr,
+                                       const sdi12_meas_response_t *meas,
+                                       bool crc,
+                                       sdi12_value_emit_fn emit,
+                                       void *user_data,
+                                       uint16_t *emitted);
+
+/**
+ * Attach caller arrays to an empty compact container.
+ *
+ * @param d         Container to set up.
+ * @param values    Array of `capacity` floats.
+ * @param decimals  Array of `capacity` bytes, or NULL.
+ * @param quality   SDI12_SOA_QUALITY_BYTES(capacity) bytes, or NULL.
+ * @param capacity  Entries in the arrays.
+ */
+void sdi12_data_soa_init(sdi12_data_soa_t *d, float *values, uint8_t *decimals,
+                         uint8_t *quality, uint16_t capacity);
+
+/**
+ * sdi12_master_collect() into a compact container, appending after
+ * d->count. The pages are walked the same way.
+ *
+ * @param ctx   Master context.
+ * @param addr  Sensor address.
+ * @param meas  Parsed atttn reply of the measurement (value_count).
+ * @param crc   Whether CRC was requested with the measurement.
+ * @param d     [in,out] Container; values land at d->count onwards.
+ * @return SDI12_OK when all values arrived; SDI12_ERR_BUFFER_OVERFLOW if
+ *         value_count exceeds the room left (nothing is sent),
+ *         SDI12_ERR_NO_DATA if the sensor ran short, SDI12_ERR_TIMEOUT or
+ *         SDI12_ERR_CRC_MISMATCH. Values already stored are kept.
+ */
+sdi12_err_t sdi12_master_collect_soa(sdi12_master_ctx_t *ctx,
+                                      char addr,
+                                      const sdi12_meas_response_t *meas,
+                                      bool crc,
+                                      sdi12_data_soa_t *d);
+
 /**
  * Start a continuous measurement (R0–R9, RC0–RC9).
  * Sends "aR0!" and parses the immediate data response.
@@ -236,9 +865,9 @@ sdi12_err_t sdi12_master_get_data(sdi12_master_ctx_t *ctx,
  * @param ctx   Master context.
  * @param addr  Sensor address.
  * @param index Continuous measurement index (0–9).
- * @param crc   Request CRC variant.
- * @param resp  [out] Parsed data response.
- * @return SDI12_OK on success.
+ * @param crc   Request CRC variant; the CRC is verified while parsing.
+ * @param resp  [out] Parsed data response (crc_valid set with crc).
+ * @return SDI12_OK on success, SDI12_ERR_CRC_MISMATCH on CRC failure.
  */
 sdi12_err_t sdi12_master_continuous(sdi12_master_ctx_t *ctx,
                                      char addr, uint8_t index, bool crc,
@@ -308,20 +937,37 @@ sdi12_err_t sdi12_master_identify_param(sdi12_master_ctx_t *ctx,
  * Request high-volume data page (D0–D999).
  * Sends "aD0!" through "aD999!" and returns the raw response.
  *
- * For ASCII responses: caller should use sdi12_master_parse_data_values().
- * For binary responses: caller should use sdi12_master_parse_binary_page().
+ * For whole aHA! results prefer sdi12_master_collect_ha_values(), which
+ * parses every page in place. For binary pages use sdi12_master_get_hv_binary_data() and decode with
+ * sdi12_bin_decode_float() and friends.
  *
  * @param ctx       Master context.
  * @param addr      Sensor address.
  * @param page      Data page 0–999.
  * @param raw_buf   [out] Raw response (after address).
  * @param raw_len   [in] Buffer capacity / [out] response length.
- * @return SDI12_OK on success.
+ * @return SDI12_OK on success, SDI12_ERR_BUFFER_OVERFLOW if the page did
+ *         not fit (raw_buf then holds the first *raw_len bytes).
  */
 sdi12_err_t sdi12_master_get_hv_data(sdi12_master_ctx_t *ctx,
                                       char addr, uint16_t page,
                                       char *raw_buf, size_t *raw_len);
 
+/**
+ * Like sdi12_master_get_hv_data(), without copying or truncating: `raw`
+ * views the page text after the address (CRC included, CR/LF not) and
+ * stays valid until the next command. Works for any aDn! page.
+ *
+ * @param ctx   Master context.
+ * @param addr  Sensor address.
+ * @param page  Data page 0–999.
+ * @param raw   [out] Page text.
+ * @return SDI12_OK on success.
+ */
+sdi12_err_t sdi12_master_get_hv_data_view(sdi12_master_ctx_t *ctx,
+                                          char addr, uint16_t page,
+                                          sdi12_span_t *raw);
+
 /**
  * Retrieve a high-volume binary data page (aDBn!) per §5.2.
  *
@@ -329,13 +975,22 @@ sdi12_err_t sdi12_master_get_hv_data(sdi12_master_ctx_t *ctx,
  *   addr(1) + packet_size(2 LE) + type(1) + payload(N) + CRC(2 LE).
  * The CRC is always present and verified.
  *
+ * The payload is received straight into out_payload with the CRC updated
+ * as it arrives; no packet-sized buffer is used. When the packet is larger
+ * than the buffer, the excess is still read and checked but discarded, and
+ * *out_len reports the full packet size so the caller can tell. Payload
+ * contents are unspecified unless SDI12_OK is returned.
+ *
  * @param ctx         Master context.
  * @param addr        Sensor address.
  * @param page        Data page 0–999.
  * @param out_type    [out] Binary data type.
  * @param out_payload [out] Payload buffer.
- * @param out_len     [in] Buffer capacity / [out] actual payload bytes.
- * @return SDI12_OK on success, SDI12_ERR_CRC_MISMATCH on CRC failure.
+ * @param out_len     [in] Buffer capacity / [out] packet payload bytes
+ *                    (may exceed the capacity; see above).
+ * @return SDI12_OK on success, SDI12_ERR_CRC_MISMATCH on CRC failure,
+ *         SDI12_ERR_BUFFER_OVERFLOW if the header announces more than
+ *         SDI12_BIN_MAX_PAYLOAD bytes.
  */
 sdi12_err_t sdi12_master_get_hv_binary_data(sdi12_master_ctx_t *ctx,
                                             char addr, uint16_t page,
@@ -343,13 +998,79 @@ sdi12_err_t sdi12_master_get_hv_binary_data(sdi12_master_ctx_t *ctx,
                                             void *out_payload,
                                             size_t *out_len);
 
+/** Attach caller memory to an empty sdi12_hv_arena_t. */
+void sdi12_hv_arena_init(sdi12_hv_arena_t *arena, void *buf, size_t cap,
+                         sdi12_hv_page_t *pages, uint16_t max_pages);
+
+/**
+ * Fetch every data page of an aHA!/aHB! result into an arena.
+ *
+ * Walks aD0!, aD1!, … (aDB0!, … for SDI12_MEAS_HIGHVOL_BINARY) back to
+ * back, stopping once meas->value_count values have arrived or a page
+ * comes back empty. Each page's command goes out as soon as the previous
+ * reply has ended and its value count is known; the previous page is then
+ * CRC-checked, stored and handed to `on_page` while the sensor answers.
+ * A break is sent only if the bus may have gone to sleep.
+ *
+ * A page that fails (no reply, bad frame, CRC) is recorded and the walk
+ * goes on; afterwards only the failed pages are requested again, for up
+ * to SDI12_HV_RETRY_ROUNDS passes. The first walk gives up after
+ * SDI12_LINK_RETRIES + 1 failures in a row.
+ *
+ * @param ctx        Master context.
+ * @param addr       Sensor address.
+ * @param meas       Parsed atttnnn reply (type and value_count).
+ * @param crc        HA pages carry a CRC (aHAC!). HB packets always do.
+ * @param arena      [in,out] Destination; its contents are replaced.
+ * @param on_page    Per-page callback, or NULL.
+ * @param user_data  Passed to on_page.
+ * @param stats      [out] Counts and pages/sec (NULL to ignore).
+ * @return SDI12_OK when every page arrived intact and the values are all
+ *         there, SDI12_ERR_BUFFER_OVERFLOW if the arena fills up, the last
+ *         page error if a page never arrived, SDI12_ERR_NO_DATA if the
+ *         sensor ran short.
+ */
+sdi12_err_t sdi12_master_collect_hv(sdi12_master_ctx_t *ctx,
+                                     char addr,
+                                     const sdi12_meas_response_t *meas,
+                                     bool crc,
+                                     sdi12_hv_arena_t *arena,
+                                     sdi12_hv_page_fn on_page,
+                                     void *user_data,
+                                     sdi12_hv_stats_t *stats);
+
 /**
- * Decode the size in bytes of a single binary value for a given type.
+ * Fetch every aD<n>! page of an aHA! result as parsed values.
+ *
+ * Each page is parsed, with its CRC checked in the same scan, straight
+ * from the receive buffer into values[*count], so a result of up to 999
+ * values lands in one caller array in order with no page text copied.
+ * The pages are walked as in sdi12_master_collect_hv(), with the next
+ * command out before the current page is parsed; a failed page is asked
+ * again at once (up to SDI12_LINK_RETRIES times) to keep the order.
  *
- * @param type  Binary data type.
- * @return Size in bytes (1–8), or 0 for invalid.
+ * @param ctx         Master context.
+ * @param addr        Sensor address.
+ * @param meas        Parsed atttnnn reply of an ASCII measurement.
+ * @param crc         Pages carry a CRC (aHAC!).
+ * @param values      [out] Value array.
+ * @param max_values  Capacity of values.
+ * @param count       [out] Values stored.
+ * @param stats       [out] Counts and pages/sec (NULL to ignore).
+ * @return SDI12_OK when meas->value_count values arrived,
+ *         SDI12_ERR_BUFFER_OVERFLOW if `values` filled up first (it then
+ *         holds the first max_values), SDI12_ERR_NO_DATA if the sensor ran
+ *         short, or the error of a page that never arrived intact.
+ *         SDI12_ERR_INVALID_COMMAND for an HB measurement.
  */
-size_t sdi12_bintype_size(sdi12_bintype_t type);
+sdi12_err_t sdi12_master_collect_ha_values(sdi12_master_ctx_t *ctx,
+                                            char addr,
+                                            const sdi12_meas_response_t *meas,
+                                            bool crc,
+                                            sdi12_value_t *values,
+                                            uint16_t max_values,
+                                            uint16_t *count,
+                                            sdi12_hv_stats_t *stats);
 
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Extended / Transparent Commands                                          */
@@ -373,6 +1094,23 @@ sdi12_err_t sdi12_master_extended(sdi12_master_ctx_t *ctx,
                                    char *resp_buf, size_t *resp_len,
                                    uint32_t timeout_ms);
 
+/**
+ * Like sdi12_master_extended(), without copying: `resp` views the whole
+ * reply as received, address through CR/LF, until the next command.
+ *
+ * @param ctx        Master context.
+ * @param addr       Sensor address.
+ * @param xcmd       Extended command body (after 'X', before '!').
+ * @param resp       [out] Reply view.
+ * @param timeout_ms Response timeout.
+ * @return SDI12_OK on success.
+ */
+sdi12_err_t sdi12_master_extended_view(sdi12_master_ctx_t *ctx,
+                                       char addr,
+                                       const char *xcmd,
+                                       sdi12_span_t *resp,
+                                       uint32_t timeout_ms);
+
 /**
  * Send an extended command and collect a multi-line response.
  * Keeps receiving additional lines as long as data arrives within
@@ -396,6 +1134,319 @@ sdi12_err_t sdi12_master_extended_multiline(sdi12_master_ctx_t *ctx,
                                              uint8_t *line_count,
                                              uint32_t timeout_ms);
 
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Non-blocking Engine                                                      */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Queue a transaction. Nothing is sent until sdi12_master_poll().
+ *
+ * The engine never calls recv or delay: response bytes arrive through
+ * sdi12_master_on_rx() and waits are deadlines checked by
+ * sdi12_master_poll(). A break is sent when the bus has been marking for
+ * SDI12_MARKING_TIMEOUT_MS or more. Transactions run one at a time in
+ * submission order; do not mix them with blocking calls on the same ctx.
+ *
+ * @param ctx  Master context.
+ * @param txn  Caller-owned transaction with the request fields set.
+ * @return SDI12_OK, SDI12_ERR_INVALID_ADDRESS or SDI12_ERR_INVALID_COMMAND.
+ */
+sdi12_err_t sdi12_master_submit(sdi12_master_ctx_t *ctx, sdi12_txn_t *txn);
+
+/**
+ * Advance the engine: send pending commands, expire timeouts and call
+ * completion callbacks.
+ *
+ * @param ctx     Master context.
+ * @param now_ms  Monotonic millisecond clock (wraps).
+ * @return Milliseconds until the engine next needs a poll (0 = poll again
+ *         now), or SDI12_POLL_IDLE when the queue is empty. Received
+ *         bytes also warrant a poll: they are only parsed here.
+ */
+uint32_t sdi12_master_poll(sdi12_master_ctx_t *ctx, uint32_t now_ms);
+
+/**
+ * Feed bytes received from the bus. Safe to call from the UART RX
+ * interrupt or DMA callback: the bytes only go into a single-producer,
+ * single-consumer ring (SDI12_RX_RING_SIZE) that sdi12_master_poll()
+ * drains, and nothing else in ctx is touched. Call it from one context
+ * only. On a multi-core host, where byte-sized volatile accesses are not
+ * enough, call it from the same thread as poll().
+ *
+ * Bytes that find the ring full are lost, and the transaction waiting
+ * for them fails with SDI12_ERR_BUFFER_OVERFLOW.
+ *
+ * @param ctx     Master context.
+ * @param data    Received bytes.
+ * @param len     Number of bytes.
+ * @param now_ms  Same clock as poll() when the bytes arrived; it marks
+ *                the last bus activity for break elision.
+ */
+void sdi12_master_on_rx(sdi12_master_ctx_t *ctx, const char *data, size_t len,
+                        uint32_t now_ms);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Survey                                                                   */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Measure every sensor on the bus concurrently.
+ *
+ * Sends aC! (or aCC!/aCn!) to each entry in turn, records each sensor's
+ * ready deadline from its ttt, then waits for and collects the D pages of
+ * whichever sensor is due next while the others are still measuring.
+ * Pages stop as soon as the announced value count has arrived. A break is
+ * sent only before the first command and after the bus has been marking
+ * for SDI12_MARKING_TIMEOUT_MS. Times come from the millis callback when
+ * set, otherwise from the transmit-time estimate.
+ *
+ * Per-sensor failures (no reply, CRC mismatch, short data) are reported in
+ * each entry's result and do not stop the survey.
+ *
+ * @param ctx      Master context.
+ * @param entries  Sensors to survey; results are written back in place.
+ * @param count    Number of entries.
+ * @param stats    [out] Timing summary (NULL to ignore).
+ * @return SDI12_OK once the survey has run, SDI12_ERR_INVALID_ADDRESS if an
+ *         entry has an invalid address (nothing is sent).
+ */
+sdi12_err_t sdi12_master_survey(sdi12_master_ctx_t *ctx,
+                                 sdi12_survey_entry_t *entries,
+                                 uint8_t count,
+                                 sdi12_survey_stats_t *stats);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Scheduler                                                                */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Estimate one run's bus occupancy at 1200 baud: break and marking,
+ * command and worst-case response lengths (SDI12_VALUE_MAX_CHARS per
+ * value, so the most D pages), the response latency allowance for each
+ * exchange and — for aM!, where no other sensor may be addressed — ttt.
+ *
+ * @param job  Job configuration.
+ * @return Estimated milliseconds.
+ */
+uint32_t sdi12_sched_job_cost(const sdi12_sched_job_t *job);
+
+/**
+ * Validate and admit a set of periodic jobs.
+ *
+ * Computes each job's cost_ms and the total load. The schedule is
+ * rejected when the load exceeds the bus, or when a job's run (plus ttt
+ * for aC!) cannot finish within its period after waiting out the longest
+ * step of any other job — runs are never interrupted mid-command. Loads
+ * above SDI12_SCHED_WARN_PERMILLE are admitted; check load_permille.
+ *
+ * All jobs are released immediately. Requires the millis callback.
+ *
+ * @param sched  Scheduler to initialise.
+ * @param ctx    Master context the jobs run on.
+ * @param jobs   Caller-owned job array.
+ * @param count  Number of jobs.
+ * @return SDI12_OK, SDI12_ERR_OVERLOAD, SDI12_ERR_CALLBACK_MISSING (no
+ *         millis), SDI12_ERR_INVALID_ADDRESS or SDI12_ERR_INVALID_COMMAND.
+ */
+sdi12_err_t sdi12_sched_init(sdi12_sched_t *sched, sdi12_master_ctx_t *ctx,
+                              sdi12_sched_job_t *jobs, uint8_t count);
+
+/**
+ * Run the next scheduling step, earliest deadline first: start a released
+ * job or collect a concurrent job whose data is ready. aM! jobs run to
+ * completion in one step (blocking through ttt); aC! jobs free the bus
+ * while measuring. A job still behind at its next release drops that
+ * release and counts an overrun.
+ *
+ * @param sched  Scheduler.
+ * @return Milliseconds until the next step is due (0 = call again now),
+ *         or SDI12_POLL_IDLE when there are no jobs.
+ */
+uint32_t sdi12_sched_poll(sdi12_sched_t *sched);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Metadata Cache                                                           */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Attach and clear a metadata cache table.
+ *
+ * @param cache    Cache.
+ * @param entries  Caller-owned entries.
+ * @param count    Number of entries.
+ * @return SDI12_OK, or SDI12_ERR_INVALID_COMMAND for NULL arguments.
+ */
+sdi12_err_t sdi12_meta_init(sdi12_meta_cache_t *cache,
+                            sdi12_meta_entry_t *entries, size_t count);
+
+/**
+ * Cached entry for an address.
+ *
+ * @return The entry, or NULL if the address is not cached.
+ */
+sdi12_meta_entry_t *sdi12_meta_find(const sdi12_meta_cache_t *cache, char addr);
+
+/**
+ * Read a sensor's full metadata: aI!, aIMn!/aICn! for each group up to
+ * the first empty one, then aIMn_nnn! (aICn_nnn! if C reports more
+ * values) for every parameter, up to SDI12_META_MAX_PARAMS in total.
+ *
+ * @param ctx    Master context.
+ * @param addr   Sensor address.
+ * @param entry  [out] Filled in; addr is set on success.
+ * @return SDI12_OK, or the error of the aI! or group query that failed.
+ */
+sdi12_err_t sdi12_meta_crawl(sdi12_master_ctx_t *ctx, char addr,
+                             sdi12_meta_entry_t *entry);
+
+/**
+ * Warm-start lookup: one aI! revalidates the cached entry. If the
+ * identification string is unchanged the entry is used as is; otherwise
+ * (or if the address is not cached) the sensor is crawled into the
+ * address's slot or a free one.
+ *
+ * @param ctx      Master context.
+ * @param cache    Cache.
+ * @param addr     Sensor address.
+ * @param entry    [out] Valid entry on success.
+ * @param crawled  [out] Optional: true if the sensor had to be crawled.
+ * @return SDI12_OK, SDI12_ERR_BUFFER_OVERFLOW if the cache is full, or a
+ *         bus error.
+ */
+sdi12_err_t sdi12_meta_refresh(sdi12_master_ctx_t *ctx, sdi12_meta_cache_t *cache,
+                               char addr, const sdi12_meta_entry_t **entry,
+                               bool *crawled);
+
+/**
+ * Metadata of one parameter.
+ *
+ * @param entry  Cached sensor.
+ * @param group  Measurement group 0–9.
+ * @param n      1-based parameter number within the group.
+ * @return The parameter, or NULL if out of range or beyond the cache.
+ */
+const sdi12_param_meta_t *sdi12_meta_param(const sdi12_meta_entry_t *entry,
+                                           uint8_t group, uint8_t n);
+
+/**
+ * Serialize the cache into a compact blob for non-volatile storage:
+ * "SM", format version, entry count, then per entry the address, the
+ * length-prefixed ident, group counts up to the last non-empty group and
+ * length-prefixed SHEF/units strings; a CRC-16 closes the blob.
+ *
+ * @param cache  Cache.
+ * @param buf    Output buffer.
+ * @param cap    Size of buf.
+ * @param len    [out] Bytes written.
+ * @return SDI12_OK, or SDI12_ERR_BUFFER_OVERFLOW if buf is too small.
+ */
+sdi12_err_t sdi12_meta_serialize(const sdi12_meta_cache_t *cache,
+                                 uint8_t *buf, size_t cap, size_t *len);
+
+/**
+ * Load a blob written by sdi12_meta_serialize(), replacing the cache's
+ * contents. On any error the cache is left empty.
+ *
+ * @param cache  Cache (after sdi12_meta_init()).
+ * @param buf    Blob.
+ * @param len    Blob length.
+ * @return SDI12_OK, SDI12_ERR_CRC_MISMATCH for a damaged blob,
+ *         SDI12_ERR_PARSE_FAILED for a malformed one, or
+ *         SDI12_ERR_BUFFER_OVERFLOW if it holds more entries than fit.
+ */
+sdi12_err_t sdi12_meta_deserialize(sdi12_meta_cache_t *cache,
+                                   const uint8_t *buf, size_t len);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Receive Framer                                                           */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Arm a framer for the response to a command that has just been sent.
+ *
+ * @param f           Framer.
+ * @param buf         Frame buffer (at least 2 bytes).
+ * @param cap         Size of buf.
+ * @param addr        Required first character ('\0' to accept any).
+ * @param expect_len  Exact frame length when known, else 0.
+ * @param now_us      Microsecond timestamp of the command's end (wraps).
+ */
+void sdi12_framer_start(sdi12_framer_t *f, char *buf, size_t cap,
+                        char addr, size_t expect_len, uint32_t now_us);
+
+/**
+ * Feed one received byte.
+ *
+ * Line-turnaround noise (non-printable bytes before the frame starts) is
+ * dropped. The first character must match `addr`, and every later one
+ * must be printable ASCII or the CR/LF terminator — anything else ends
+ * the frame as GARBAGE immediately. A byte arriving more than
+ * SDI12_CHAR_US + SDI12_INTERCHAR_MAX_US after the previous one means
+ * the frame had already ended: TRUNCATED, and the byte is not stored.
+ *
+ * @param f     Framer.
+ * @param c     Received byte.
+ * @param t_us  Microsecond arrival timestamp (end of the stop bit).
+ * @return Frame status; once not PENDING it no longer changes.
+ */
+sdi12_frame_status_t sdi12_framer_feed(sdi12_framer_t *f, char c, uint32_t t_us);
+
+/**
+ * Check for silence: TIMEOUT if no byte has arrived within
+ * SDI12_RESPONSE_TIMEOUT_MS plus one character, TRUNCATED if the frame
+ * stopped mid-way for longer than one character plus the maximum gap.
+ *
+ * @param f       Framer.
+ * @param now_us  Current microsecond timestamp.
+ * @return Frame status.
+ */
+sdi12_frame_status_t sdi12_framer_poll(sdi12_framer_t *f, uint32_t now_us);
+
+/**
+ * Bound the frame's length, typically with sdi12_master_response_len()
+ * for the command just sent. A frame that ends shorter than len.min is
+ * TRUNCATED; one that grows past len.max is GARBAGE on the extra byte,
+ * without waiting for it to finish.
+ *
+ * @param f    Framer (after sdi12_framer_start()).
+ * @param len  Length bounds; zero fields leave that side unbounded.
+ */
+void sdi12_framer_expect(sdi12_framer_t *f, sdi12_resp_len_t len);
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Response Length Model                                                    */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Expected response length for a command, from its kind:
+ *
+ *   a! ?! aAb!            "a<CR><LF>"                 3
+ *   aM! aMC! aMn! aV!     atttn                       7
+ *   aC! aCC! aCn!         atttnn                      8
+ *   aHA! aHB!             atttnnn                     9
+ *   aI!                   identification              22–35
+ *   aDn! aRn!             values (≤ 75 chars) + CRC   3–81
+ *   aX..! and others      anything                    3–SDI12_RESP_MAX_CHARS
+ *
+ * Identify-measurement commands (aIM!, aIC!, …) are bounded by the
+ * matching atttn form; a D page after aM! can be tightened by the caller
+ * to 1 + SDI12_M_VALUES_MAX_CHARS + CRC + 2.
+ *
+ * @param cmd  Command string, e.g. "0M!".
+ * @return Length bounds; {0, 0} if cmd is NULL.
+ */
+sdi12_resp_len_t sdi12_master_response_len(const char *cmd);
+
+/**
+ * Worst-case time from the start of sending `cmd` to the end of the
+ * longest valid reply: command line time + SDI12_RESPONSE_TIMEOUT_MS +
+ * max reply line time. A transaction still open after this is dead.
+ *
+ * @param cmd  Command string.
+ * @return Deadline in milliseconds, 0 if cmd is NULL.
+ */
+uint32_t sdi12_master_response_deadline_ms(const char *cmd);
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Response Parsing Utilities                                               */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -423,8 +1474,10 @@ sdi12_err_t sdi12_master_parse_meas_response(const char *resp_str, size_t len,
  * @param values    [out] Array of parsed values.
  * @param max_values Size of values array.
  * @param count     [out] Number of values parsed.
- * @param verify_crc If true, verify and strip CRC-16 before parsing.
- * @return SDI12_OK on success, SDI12_ERR_CRC if CRC fails.
+ * @param verify_crc If true, strip the 3 CRC characters. The CRC also
+ *                   covers the address, which this string lacks, so
+ *                   sdi12_master_get_data() and friends verify it instead.
+ * @return SDI12_OK on success.
  */
 sdi12_err_t sdi12_master_parse_data_values(const char *resp_str, size_t len,
                                             sdi12_value_t *values,
@@ -432,6 +1485,26 @@ sdi12_err_t sdi12_master_parse_data_values(const char *resp_str, size_t len,
                                             uint8_t *count,
                                             bool verify_crc);
 
+/**
+ * Parse a data response string into exact decimals.
+ *
+ * Same scanning rules as sdi12_master_parse_data_values(); each value keeps
+ * its digits and decimal count, and nothing is converted to float.
+ *
+ * @param resp_str  Raw data response (after address char).
+ * @param len       Length of the data string.
+ * @param values    [out] Array of parsed values.
+ * @param max_values Size of values array.
+ * @param count     [out] Number of values parsed.
+ * @param verify_crc If true, strip the 3 CRC characters (not verified).
+ * @return SDI12_OK on success.
+ */
+sdi12_err_t sdi12_master_parse_data_decimals(const char *resp_str, size_t len,
+                                             sdi12_decimal_t *values,
+                                             uint8_t max_values,
+                                             uint8_t *count,
+                                             bool verify_crc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,13 +47,15 @@ static uint8_t collect_group_indices(const sdi12_sensor_ctx_t *ctx,
 /** Format a single value with mandatory sign prefix per SDI-12 spec. */
 static int format_value(char *buf, size_t buflen, sdi12_value_t val)
 {
-    char sign = val.value >= 0.0f ? '+' : '-';
-    float absval = val.value >= 0.0f ? val.value : -val.value;
+    return sdi12_decimal_format(buf, buflen, sdi12_decimal_from_value(val));
+}
 
-    if (val.decimals == 0) {
-        return snprintf(buf, buflen, "%c%lu", sign, (unsigned long)absval);
-    } else {
-        return snprintf(buf, buflen, "%c%.*f", sign, val.decimals, (double)absval);
+/** Float view of the data cache, for the format_binary_page callback. */
+static void cache_values(const sdi12_sensor_ctx_t *ctx, sdi12_value_t *out)
+{
+    for (uint8_t i = 0; i < ctx->data_cache_count; i++) {
+        out[i].value = sdi12_decimal_to_float(ctx->data_cache[i]);
+        out[i].decimals = ctx->data_cache[i].decimals;
     }
 }
 
@@ -64,7 +66,7 @@ static int format_value(char *buf, size_t buflen, sdi12_value_t val)
  * Returns SDI12_OK if values were written, SDI12_ERR_NO_DATA if page empty.
  */
 static sdi12_err_t format_data_page(sdi12_sensor_ctx_t *ctx,
-                                     uint8_t page,
+                                     uint16_t page,
                                      uint16_t max_value_chars)
 {
     char *buf = ctx->resp_buf;
@@ -74,38 +76,30 @@ static sdi12_err_t format_data_page(sdi12_sensor_ctx_t *ctx,
     size_t pos = 1;
 
     /* Walk through cached values, skipping those on earlier pages */
-    uint8_t current_page = 0;
+    uint16_t current_page = 0;
+    size_t page_used = 0;
     uint8_t i = 0;
     bool any_on_page = false;
 
     while (i < ctx->data_cache_count) {
         char vbuf[SDI12_VALUE_MAX_CHARS + 1];
-        int vlen = format_value(vbuf, sizeof(vbuf), ctx->data_cache[i]);
+        int vlen = sdi12_decimal_format(vbuf, sizeof(vbuf), ctx->data_cache[i]);
 
         if (vlen <= 0) {
             i++;
             continue;
         }
 
-        /* Would this value fit on the current page? */
-        size_t page_used = pos - 1; /* subtract address char */
-        if (current_page > 0) {
-            /* Reset for new page tracking — pos is already at address */
-            /* This is tracked implicitly */
-        }
-
-        if (page_used + (size_t)vlen > max_value_chars && page_used > 0) {
-            /* Start a new page */
+        /* Would this value fit on the current page (and in resp_buf,
+         * leaving room for the address, CRC, CR/LF and null)? */
+        if ((page_used + (size_t)vlen > max_value_chars ||
+             1 + page_used + (size_t)vlen + 6 > buflen) && page_used > 0) {
             current_page++;
-            pos = 1; /* reset (address already placed) */
             page_used = 0;
         }
 
         if (current_page == page) {
             /* This value belongs to the requested page */
-            if (pos + (size_t)vlen >= buflen - 6) { /* room for CRC + CRLF + null */
-                break;
-            }
             memcpy(buf + pos, vbuf, (size_t)vlen);
             pos += (size_t)vlen;
             any_on_page = true;
@@ -113,6 +107,7 @@ static sdi12_err_t format_data_page(sdi12_sensor_ctx_t *ctx,
             break;
         }
 
+        page_used += (size_t)vlen;
         i++;
     }
 
@@ -148,6 +143,119 @@ static void send_response(sdi12_sensor_ctx_t *ctx)
     }
 }
 
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Streaming Statistics                                                     */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Square root by Newton iteration — keeps the library free of libm. */
+static float stats_sqrt(float x)
+{
+    if (x <= 0.0f) return 0.0f;
+    float r = x > 1.0f ? x : 1.0f;
+    for (int i = 0; i < 32; i++) {
+        float next = 0.5f * (r + x / r);
+        if (next >= r) break;
+        r = next;
+    }
+    return r;
+}
+
+/** Welford update with one sample. */
+static void stats_add(sdi12_stats_t *st, float x)
+{
+    st->n++;
+    float delta = x - st->mean;
+    st->mean += delta / (float)st->n;
+    st->m2 += delta * (x - st->mean);
+    if (st->n == 1 || x < st->min) st->min = x;
+    if (st->n == 1 || x > st->max) st->max = x;
+}
+
+/** Start a new interval. */
+static void stats_reset(sdi12_stats_t *st)
+{
+    st->n = 0;
+    st->mean = 0.0f;
+    st->m2 = 0.0f;
+    st->min = 0.0f;
+    st->max = 0.0f;
+}
+
+/** Current value of one statistic. */
+static float stats_get(const sdi12_stats_t *st, uint8_t stat)
+{
+    switch (stat) {
+    case SDI12_STAT_MEAN:   return st->mean;
+    case SDI12_STAT_MIN:    return st->min;
+    case SDI12_STAT_MAX:    return st->max;
+    case SDI12_STAT_STDDEV:
+        return st->n > 1 ? stats_sqrt(st->m2 / (float)(st->n - 1)) : 0.0f;
+    case SDI12_STAT_COUNT:  return (float)st->n;
+    default:                return 0.0f;
+    }
+}
+
+/** True if any param of the group reports statistics. */
+static bool group_has_stats(const sdi12_sensor_ctx_t *ctx, uint8_t group)
+{
+    for (uint8_t i = 0; i < ctx->param_count; i++) {
+        if (ctx->params[i].active && ctx->params[i].group == group &&
+            ctx->params[i].stats_slot) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Close the interval of every accumulator reported by the group. */
+static void stats_reset_group(sdi12_sensor_ctx_t *ctx, uint8_t group)
+{
+    for (uint8_t i = 0; i < ctx->param_count; i++) {
+        const sdi12_param_reg_t *p = &ctx->params[i];
+        if (p->active && p->group == group && p->stats_slot) {
+            stats_reset(&ctx->stats[p->stats_slot - 1]);
+        }
+    }
+}
+
+/** Read a param — statistics from their accumulator, others via read_param. */
+static sdi12_value_t param_value(sdi12_sensor_ctx_t *ctx, uint8_t idx)
+{
+    const sdi12_param_reg_t *p = &ctx->params[idx];
+    if (p->stats_slot) {
+        sdi12_value_t v;
+        v.value = stats_get(&ctx->stats[p->stats_slot - 1], p->stat);
+        v.decimals = p->decimals;
+        return v;
+    }
+    return ctx->cb.read_param(idx, ctx->cb.user_data);
+}
+
+/**
+ * Build and send a binary packet per §5.2 (Table 14):
+ *   addr(1) + pkt_size(2 LE) + type(1) + payload(N) + CRC(2 LE)
+ */
+static void send_binary_packet(sdi12_sensor_ctx_t *ctx, uint8_t type,
+                               const char *payload, uint16_t size)
+{
+    char *pkt = ctx->resp_buf;
+
+    pkt[0] = ctx->address;
+    pkt[1] = (char)(size & 0xFF);
+    pkt[2] = (char)((size >> 8) & 0xFF);
+    pkt[3] = (char)type;
+    if (size > 0)
+        memcpy(pkt + 4, payload, size);
+
+    size_t data_end = 4 + (size_t)size;
+    uint16_t crc = sdi12_crc16(pkt, data_end);
+    pkt[data_end]     = (char)(crc & 0xFF);
+    pkt[data_end + 1] = (char)((crc >> 8) & 0xFF);
+
+    ctx->resp_len = data_end + 2;
+    send_response(ctx);
+}
+
 /** Populate data cache synchronously by reading all params in a group. */
 static void read_group_sync(sdi12_sensor_ctx_t *ctx, uint8_t group)
 {
@@ -158,13 +266,521 @@ static void read_group_sync(sdi12_sensor_ctx_t *ctx, uint8_t group)
     for (uint8_t i = 0; i < n && ctx->data_cache_count < SDI12_MAX_PARAMS; i++) {
         if (ctx->cb.read_param) {
             ctx->data_cache[ctx->data_cache_count] =
-                ctx->cb.read_param(indices[i], ctx->cb.user_data);
+                sdi12_decimal_from_value(param_value(ctx, indices[i]));
             ctx->data_cache_count++;
         }
     }
     ctx->data_available = true;
 }
 
+/** True if the group has a published sample within its max-age policy. */
+static bool sample_fresh(const sdi12_sensor_ctx_t *ctx, uint8_t group)
+{
+    const sdi12_sampler_t *s = &ctx->samplers[group];
+    if (s->period_ms == 0 || !s->valid) return false;
+    if (s->max_age_ms == 0) return true;
+    return (uint32_t)(ctx->now_ms - s->sampled_at_ms) <= s->max_age_ms;
+}
+
+/**
+ * Fill the spare ring slot for a group, then publish it.
+ * With values == NULL every param is read via read_param; otherwise the
+ * first `count` values (in group order) are taken from the array.
+ */
+static void sample_group(sdi12_sensor_ctx_t *ctx, uint8_t group,
+                         const sdi12_value_t *values, uint8_t count)
+{
+    sdi12_sampler_t *s = &ctx->samplers[group];
+    uint8_t slot = s->valid ? (uint8_t)((s->slot + 1) % SDI12_SAMPLE_SLOTS) : 0;
+
+    uint8_t indices[SDI12_MAX_PARAMS];
+    uint8_t n = collect_group_indices(ctx, group, indices, SDI12_MAX_PARAMS);
+    for (uint8_t i = 0; i < n; i++) {
+        if (!values) {
+            ctx->sample_ring[slot][indices[i]] = param_value(ctx, indices[i]);
+        } else {
+            sdi12_value_t none = {0.0f, 0};
+            ctx->sample_ring[slot][indices[i]] = (i < count) ? values[i] : none;
+        }
+    }
+
+    /* Publish only after the slot is complete */
+    s->sampled_at_ms = ctx->now_ms;
+    s->slot = slot;
+    s->valid = true;
+}
+
+/** Copy a group's latest published sample into the data cache. */
+static void load_sample(sdi12_sensor_ctx_t *ctx, uint8_t group)
+{
+    const sdi12_value_t *ring = ctx->sample_ring[ctx->samplers[group].slot];
+    uint8_t indices[SDI12_MAX_PARAMS];
+    uint8_t n = collect_group_indices(ctx, group, indices, SDI12_MAX_PARAMS);
+
+    for (uint8_t i = 0; i < n; i++) {
+        ctx->data_cache[i] = sdi12_decimal_from_value(ring[indices[i]]);
+    }
+    ctx->data_cache_count = n;
+    ctx->data_available = true;
+}
+
+/**
+ * Populate data cache for a group — from the background sample when it is
+ * fresh, otherwise by reading all params synchronously.
+ */
+static void load_group(sdi12_sensor_ctx_t *ctx, uint8_t group)
+{
+    if (!sample_fresh(ctx, group)) {
+        read_group_sync(ctx, group);
+        return;
+    }
+    load_sample(ctx, group);
+}
+
+/** Write the atttn / atttnn / atttnnn reply for a measurement command. */
+static void format_meas_reply(sdi12_sensor_ctx_t *ctx, sdi12_meas_type_t type,
+                              uint16_t ttt, uint16_t n)
+{
+    if (type == SDI12_MEAS_STANDARD || type == SDI12_MEAS_VERIFICATION) {
+        snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
+                 "%c%03u%u\r\n", ctx->address, ttt, n > 9 ? 9 : n);
+    } else if (type == SDI12_MEAS_CONCURRENT) {
+        snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
+                 "%c%03u%02u\r\n", ctx->address, ttt, n > 99 ? 99 : n);
+    } else {
+        snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
+                 "%c%03u%03u\r\n", ctx->address, ttt, (unsigned)n);
+    }
+}
+
+/** Leave the measuring state, sending a service request for M/V. */
+static void finish_measurement(sdi12_sensor_ctx_t *ctx)
+{
+    /* Send service request for standard/verification measurements only */
+    ctx->resp_len = 0;  /* text response — strlen is safe */
+    if (ctx->state == SDI12_STATE_MEASURING) {
+        /* Standard M/V — service request required */
+        snprintf(ctx->resp_buf, sizeof(ctx->resp_buf), "%c\r\n", ctx->address);
+
+        if (ctx->cb.service_request) {
+            ctx->cb.service_request(ctx->cb.user_data);
+        } else {
+            send_response(ctx);
+        }
+        ctx->state = SDI12_STATE_DATA_READY;
+    } else if (ctx->state == SDI12_STATE_MEASURING_C) {
+        /* Concurrent — NO service request per spec */
+        ctx->state = SDI12_STATE_DATA_READY;
+    }
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Predictive Pre-measurement                                               */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Learn the master's polling cadence from an aM!/aC! arrival. */
+static void predict_observe(sdi12_sensor_ctx_t *ctx, uint8_t group,
+                            sdi12_meas_type_t type)
+{
+    sdi12_predictor_t *p = &ctx->predictors[group];
+    uint32_t now = ctx->now_ms;
+
+    if (p->seen) {
+        uint32_t interval = now - p->last_poll_ms;
+        uint32_t est = p->interval_ms;
+        uint32_t diff = interval > est ? interval - est : est - interval;
+
+        if (est != 0 && diff <= est / SDI12_PREDICT_TOLERANCE_DIV) {
+            /* Smooth jitter: est += (interval - est) / 4 */
+            p->interval_ms = est - est / 4 + interval / 4;
+            if (p->confidence < UINT8_MAX) p->confidence++;
+        } else {
+            p->interval_ms = interval;
+            p->confidence = 0;
+        }
+    }
+
+    p->last_poll_ms = now;
+    p->type = type;
+    p->seen = true;
+    ctx->predict_stats.polls++;
+}
+
+/**
+ * Answer an aM!/aC! from a pre-measurement when one is usable.
+ * Returns true if the reply has been formatted into resp_buf.
+ */
+static bool predict_serve(sdi12_sensor_ctx_t *ctx, uint8_t group,
+                          sdi12_meas_type_t type, uint8_t n)
+{
+    sdi12_predictor_t *p = &ctx->predictors[group];
+    uint8_t state = p->state;
+
+    predict_observe(ctx, group, type);
+    p->state = SDI12_PREDICT_IDLE;
+
+    if (state == SDI12_PREDICT_READY) {
+        const sdi12_sampler_t *s = &ctx->samplers[group];
+        uint32_t age = ctx->now_ms - s->sampled_at_ms;
+
+        /* A prefetch left over from a skipped poll is too old to serve */
+        if (s->valid && age <= p->interval_ms / 2) {
+            load_sample(ctx, group);
+            format_meas_reply(ctx, type, 0, n);
+            ctx->state = SDI12_STATE_DATA_READY;
+            ctx->predict_stats.hits++;
+            return true;
+        }
+    } else if (state == SDI12_PREDICT_PENDING &&
+               ctx->prefetch_pending && ctx->prefetch_group == group) {
+        /* Adopt the running acquisition; measurement_done completes it */
+        uint32_t elapsed = ctx->now_ms - p->started_ms;
+        uint32_t remaining = p->lead_ms > elapsed ? p->lead_ms - elapsed : 0;
+        uint16_t ttt = (uint16_t)((remaining + 999) / 1000);
+        if (ttt == 0) ttt = 1;
+
+        ctx->prefetch_pending = false;
+        ctx->data_available = false;
+        format_meas_reply(ctx, type, ttt, n);
+        ctx->state = (type == SDI12_MEAS_STANDARD) ? SDI12_STATE_MEASURING
+                                                   : SDI12_STATE_MEASURING_C;
+        ctx->predict_stats.late++;
+        return true;
+    }
+
+    ctx->predict_stats.misses++;
+    return false;
+}
+
+/** Start a pre-measurement for a group ahead of its predicted poll. */
+static void predict_start(sdi12_sensor_ctx_t *ctx, uint8_t group)
+{
+    sdi12_predictor_t *p = &ctx->predictors[group];
+
+    p->started_ms = ctx->now_ms;
+    ctx->predict_stats.prefetches++;
+
+    if (ctx->cb.start_measurement) {
+        uint16_t ttt = ctx->cb.start_measurement(group, p->type, ctx->cb.user_data);
+        if (ttt > 999) ttt = 999;
+        p->lead_ms = (uint32_t)ttt * 1000;
+
+        if (ttt > 0) {
+            p->state = SDI12_PREDICT_PENDING;
+            ctx->prefetch_group = group;
+            ctx->prefetch_pending = true;
+            return;
+        }
+    }
+
+    sample_group(ctx, group, NULL, 0);
+    p->state = SDI12_PREDICT_READY;
+}
+
+/**
+ * Make way for a bus acquisition while a prefetch is running. A prefetch
+ * the platform cannot stop stays pending: its completion arrives first
+ * and measurement_done files it under the prefetch group.
+ */
+static void predict_cancel(sdi12_sensor_ctx_t *ctx)
+{
+    if (!ctx->prefetch_pending || !ctx->cb.abort_measurement) return;
+
+    uint8_t g = ctx->prefetch_group;
+    if (ctx->cb.abort_measurement(g, ctx->cb.user_data)) {
+        ctx->predictors[g].state = SDI12_PREDICT_IDLE;
+        ctx->prefetch_pending = false;
+    }
+}
+
+/** Start at most one pre-measurement whose lead window has opened. */
+static void predict_tick(sdi12_sensor_ctx_t *ctx)
+{
+    if (ctx->prefetch_pending) return;
+    if (ctx->state == SDI12_STATE_MEASURING ||
+        ctx->state == SDI12_STATE_MEASURING_C) return;
+
+    for (uint8_t g = 0; g < SDI12_MAX_MEAS_GROUPS; g++) {
+        const sdi12_predictor_t *p = &ctx->predictors[g];
+        if (p->state != SDI12_PREDICT_IDLE) continue;
+        if (p->confidence < SDI12_PREDICT_MIN_CONFIDENCE) continue;
+        if (count_group(ctx, g) == 0) continue;
+
+        uint32_t since = ctx->now_ms - p->last_poll_ms;
+        uint32_t lead = p->lead_ms + ctx->predict_guard_ms;
+        uint32_t open_at = p->interval_ms > lead ? p->interval_ms - lead : 0;
+        uint32_t close_at = p->interval_ms + p->interval_ms / SDI12_PREDICT_TOLERANCE_DIV;
+
+        /* Not yet due, or the poll is overdue and this cycle was skipped */
+        if (since < open_at || since > close_at) continue;
+
+        predict_start(ctx, g);
+        return;
+    }
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Shared Acquisition                                                       */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/**
+ * Publish one acquisition to every covered group. With params == NULL the
+ * values are read via read_param; otherwise params is indexed by param.
+ */
+static void shared_publish(sdi12_sensor_ctx_t *ctx,
+                           const sdi12_value_t *params, uint8_t count)
+{
+    for (uint8_t g = 0; g < SDI12_MAX_MEAS_GROUPS; g++) {
+        if (!(ctx->shared_mask & (1u << g))) continue;
+
+        if (!params) {
+            sample_group(ctx, g, NULL, 0);
+            continue;
+        }
+
+        uint8_t indices[SDI12_MAX_PARAMS];
+        sdi12_value_t vals[SDI12_MAX_PARAMS];
+        uint8_t n = collect_group_indices(ctx, g, indices, SDI12_MAX_PARAMS);
+        for (uint8_t i = 0; i < n; i++) {
+            sdi12_value_t none = {0.0f, 0};
+            vals[i] = (indices[i] < count) ? params[indices[i]] : none;
+        }
+        sample_group(ctx, g, vals, n);
+    }
+
+    /* Without a tick clock the snapshot's age is unknown: never reuse it */
+    ctx->shared_at_ms = ctx->now_ms;
+    ctx->shared_valid = ctx->ticked;
+}
+
+/**
+ * Answer an aMn!/aCn! for a covered group from the shared snapshot, or
+ * start (or join) the shared acquisition. Returns false if not covered.
+ */
+static bool shared_serve(sdi12_sensor_ctx_t *ctx, uint8_t group,
+                         sdi12_meas_type_t type, uint8_t n)
+{
+    if (!(ctx->shared_mask & (1u << group))) return false;
+
+    uint16_t ttt = 0;
+
+    /* Aged by the shared acquisition alone: a background sample or
+     * prefetch of one group does not renew the snapshot */
+    if (ctx->shared_valid &&
+        (uint32_t)(ctx->now_ms - ctx->shared_at_ms) <= ctx->shared_validity_ms) {
+        /* Snapshot still valid — answer from it */
+    } else if (ctx->shared_pending) {
+        uint32_t elapsed = ctx->now_ms - ctx->shared_started_ms;
+        uint32_t total = (uint32_t)ctx->shared_ttt * 1000;
+        ttt = (uint16_t)(elapsed < total ? (total - elapsed + 999) / 1000 : 1);
+    } else {
+        if (ctx->cb.start_measurement) {
+            predict_cancel(ctx);
+            ttt = ctx->cb.start_measurement(SDI12_SHARED_GROUP, type,
+                                            ctx->cb.user_data);
+            if (ttt > 999) ttt = 999;
+        }
+        if (ttt > 0) {
+            ctx->shared_pending = true;
+            ctx->shared_started_ms = ctx->now_ms;
+            ctx->shared_ttt = ttt;
+        } else {
+            shared_publish(ctx, NULL, 0);
+        }
+    }
+
+    if (ttt == 0) {
+        load_sample(ctx, group);
+        ctx->state = SDI12_STATE_DATA_READY;
+    } else {
+        ctx->data_available = false;
+        ctx->state = (type == SDI12_MEAS_STANDARD) ? SDI12_STATE_MEASURING
+                                                   : SDI12_STATE_MEASURING_C;
+    }
+    format_meas_reply(ctx, type, ttt, n);
+    return true;
+}
+
+/** True while the running command waits for sdi12_sensor_shared_done(). */
+static bool shared_awaited(const sdi12_sensor_ctx_t *ctx)
+{
+    return ctx->shared_pending &&
+           (ctx->pending_meas_type == SDI12_MEAS_STANDARD ||
+            ctx->pending_meas_type == SDI12_MEAS_CONCURRENT) &&
+           (ctx->shared_mask & (1u << ctx->pending_meas_group));
+}
+
+/* ────────────────────────────────────────────────────────────────────────── */
+/*  Sample History                                                           */
+/* ────────────────────────────────────────────────────────────────────────── */
+
+/** Ring slot of the oldest selected record. */
+static uint16_t hist_sel_first(const sdi12_sensor_ctx_t *ctx, const sdi12_history_t *h)
+{
+    return (uint16_t)((ctx->hist_sel_newest + h->capacity + 1u - ctx->hist_sel_count)
+                      % h->capacity);
+}
+
+/**
+ * Value `v` of the open selection: pairs of (age s, value), oldest first.
+ * The selection is pinned to ring slots, so records added since do not
+ * move it.
+ */
+static sdi12_value_t hist_value(const sdi12_sensor_ctx_t *ctx, uint16_t v)
+{
+    const sdi12_history_t *h = &ctx->history[ctx->hist_sel - 1];
+    uint16_t pos = (uint16_t)((hist_sel_first(ctx, h) + v / 2) % h->capacity);
+    const sdi12_history_rec_t *r = &h->recs[pos];
+
+    if (v % 2 == 0) {
+        sdi12_value_t age = {(float)((ctx->hist_ref_ms - r->t_ms) / 1000u), 0};
+        return age;
+    }
+    return r->v;
+}
+
+/** Close the selection; its records may be overwritten again. */
+static void hist_end(sdi12_sensor_ctx_t *ctx)
+{
+    ctx->hist_sel = 0;
+    ctx->hist_download = false;
+    ctx->hist_served = false;
+}
+
+/**
+ * Format HA data page `page` of the selection. Pages are packed like
+ * format_data_page(); a memo of the last page's start makes sequential
+ * and repeated requests O(page) instead of O(selection).
+ */
+static void format_history_page(sdi12_sensor_ctx_t *ctx, uint16_t page)
+{
+    char *buf = ctx->resp_buf;
+    size_t buflen = sizeof(ctx->resp_buf);
+    uint16_t total = (uint16_t)(ctx->hist_sel_count * 2u);
+
+    uint16_t cur = 0;
+    uint16_t v = 0;
+    if (ctx->hist_memo_page <= page) {
+        cur = ctx->hist_memo_page;
+        v = ctx->hist_memo_start;
+    }
+
+    buf[0] = ctx->address;
+    size_t pos = 1;
+
+    while (v < total) {
+        char vbuf[SDI12_VALUE_MAX_CHARS + 1];
+        int vlen = format_value(vbuf, sizeof(vbuf), hist_value(ctx, v));
+        if (vlen <= 0) {
+            v++;
+            continue;
+        }
+
+        if (pos - 1 + (size_t)vlen > SDI12_C_VALUES_MAX_CHARS && pos > 1) {
+            if (cur == page) break;
+            cur++;
+            pos = 1;
+        }
+        if (pos == 1 && cur == page) {
+            ctx->hist_memo_page = page;
+            ctx->hist_memo_start = v;
+        }
+        if (cur == page) {
+            memcpy(buf + pos, vbuf, (size_t)vlen);
+        }
+        pos += (size_t)vlen;
+        v++;
+    }
+
+    if (cur != page) pos = 1;   /* past the last page */
+    if (v >= total) ctx->hist_served = true;
+    ctx->hist_touch_ms = ctx->now_ms;
+    buf[pos] = '\0';
+
+    if (ctx->crc_requested) {
+        sdi12_crc_append(buf, buflen);
+    } else {
+        buf[pos]     = '\r';
+        buf[pos + 1] = '\n';
+        buf[pos + 2] = '\0';
+    }
+}
+
+/** Send HB page `page` of the selection as FLOAT32 (age s, value) pairs. */
+static void send_history_binary_page(sdi12_sensor_ctx_t *ctx, uint16_t page)
+{
+    enum { PAIRS = (SDI12_MAX_RESPONSE_LEN - SDI12_BIN_PKT_OVERHEAD) / 8 };
+    char payload[PAIRS * 8];
+    uint16_t size = 0;
+
+    uint32_t first = (uint32_t)page * PAIRS;
+    if (first + PAIRS >= ctx->hist_sel_count) ctx->hist_served = true;
+    ctx->hist_touch_ms = ctx->now_ms;
+    for (uint32_t p = first; p < first + PAIRS && p < ctx->hist_sel_count; p++) {
+        for (uint16_t half = 0; half < 2; half++) {
+            float f = hist_value(ctx, (uint16_t)(p * 2 + half)).value;
+            uint32_t bits;
+            memcpy(&bits, &f, sizeof(bits));
+            payload[size++] = (char)(bits & 0xFF);
+            payload[size++] = (char)((bits >> 8) & 0xFF);
+            payload[size++] = (char)((bits >> 16) & 0xFF);
+            payload[size++] = (char)((bits >> 24) & 0xFF);
+        }
+    }
+
+    send_binary_packet(ctx, size ? SDI12_BINTYPE_FLOAT32 : SDI12_BINTYPE_INVALID,
+                       payload, size);
+}
+
+/** Parse an unsigned decimal at *p, advancing it. */
+static uint32_t parse_uint(const char **p, const char *end)
+{
+    uint32_t v = 0;
+    while (*p < end && **p >= '0' && **p <= '9') {
+        if (v < 100000u) v = v * 10u + (uint32_t)(**p - '0');
+        (*p)++;
+    }
+    return v;
+}
+
+/** Handle aXHIST<param>,<offset>,<count>! — select a history range. */
+static sdi12_err_t handle_history_select(sdi12_sensor_ctx_t *ctx,
+                                         const char *args, size_t len)
+{
+    const char *p = args;
+    const char *end = args + len;
+
+    uint32_t param = parse_uint(&p, end);
+    uint32_t offset = 0, count = 0;
+    if (p < end && *p == ',') { p++; offset = parse_uint(&p, end); }
+    if (p < end && *p == ',') { p++; count = parse_uint(&p, end); }
+
+    hist_end(ctx);
+    for (uint8_t i = 0; i < ctx->history_count; i++) {
+        const sdi12_history_t *h = &ctx->history[i];
+        if (h->param != param) continue;
+
+        uint32_t avail = offset < h->count ? h->count - offset : 0;
+        if (count > avail) count = avail;
+        if (count > SDI12_HISTORY_MAX_SELECT) count = SDI12_HISTORY_MAX_SELECT;
+
+        if (count > 0) {
+            ctx->hist_sel = (uint8_t)(i + 1);
+            ctx->hist_sel_newest = (uint16_t)((h->head + h->capacity - 1u - offset)
+                                              % h->capacity);
+            ctx->hist_sel_count = (uint16_t)count;
+            ctx->hist_ref_ms = ctx->now_ms;
+            ctx->hist_touch_ms = ctx->now_ms;
+        }
+        break;
+    }
+
+    snprintf(ctx->resp_buf, sizeof(ctx->resp_buf), "%c+%u\r\n",
+             ctx->address, ctx->hist_sel ? (unsigned)ctx->hist_sel_count : 0u);
+    send_response(ctx);
+    return SDI12_OK;
+}
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Command Handlers                                                         */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -200,61 +816,81 @@ static sdi12_err_t handle_measurement(sdi12_sensor_ctx_t *ctx,
     ctx->pending_meas_type = type;
     ctx->pending_meas_group = group;
 
+    /* aHA!/aHB! after aXHIST — serve the selected history range */
+    if (type == SDI12_MEAS_HIGHVOL_ASCII || type == SDI12_MEAS_HIGHVOL_BINARY) {
+        if (ctx->hist_sel) {
+            ctx->hist_download = true;
+            ctx->hist_served = false;
+            ctx->hist_touch_ms = ctx->now_ms;
+            ctx->hist_memo_page = 0;
+            ctx->hist_memo_start = 0;
+            format_meas_reply(ctx, type, 0, (uint16_t)(ctx->hist_sel_count * 2u));
+            ctx->state = SDI12_STATE_DATA_READY;
+            send_response(ctx);
+            return SDI12_OK;
+        }
+    } else {
+        hist_end(ctx);
+    }
+
     uint8_t n = count_group(ctx, group);
 
     /* If sensor has no data for this group, respond with zero */
     if (n == 0) {
-        if (type == SDI12_MEAS_STANDARD || type == SDI12_MEAS_VERIFICATION) {
-            snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
-                     "%c0000\r\n", ctx->address);
-        } else {
-            snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
-                     "%c00000\r\n", ctx->address);
-        }
+        format_meas_reply(ctx, type, 0, 0);
+        send_response(ctx);
+        return SDI12_OK;
+    }
+
+    /* Statistics are computed here — report and start a new interval */
+    if (group_has_stats(ctx, group)) {
+        read_group_sync(ctx, group);
+        stats_reset_group(ctx, group);
+        format_meas_reply(ctx, type, 0, n);
+        ctx->state = SDI12_STATE_DATA_READY;
         send_response(ctx);
         return SDI12_OK;
     }
 
+    if (ctx->shared_mask &&
+        (type == SDI12_MEAS_STANDARD || type == SDI12_MEAS_CONCURRENT) &&
+        shared_serve(ctx, group, type, n)) {
+        send_response(ctx);
+        return SDI12_OK;
+    }
+
+    if (ctx->predict_enabled &&
+        (type == SDI12_MEAS_STANDARD || type == SDI12_MEAS_CONCURRENT)) {
+        if (predict_serve(ctx, group, type, n)) {
+            send_response(ctx);
+            return SDI12_OK;
+        }
+    }
+
     /* Check if async measurement is supported */
     if (ctx->cb.start_measurement) {
+        predict_cancel(ctx);
         uint16_t ttt = ctx->cb.start_measurement(group, type, ctx->cb.user_data);
         if (ttt > 999) ttt = 999;
+        ctx->predictors[group].lead_ms = (uint32_t)ttt * 1000;
 
+        format_meas_reply(ctx, type, ttt, n);
         if (type == SDI12_MEAS_STANDARD || type == SDI12_MEAS_VERIFICATION) {
-            snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
-                     "%c%03u%u\r\n", ctx->address, ttt, n > 9 ? 9 : n);
             ctx->state = (ttt > 0) ? SDI12_STATE_MEASURING : SDI12_STATE_DATA_READY;
-        } else if (type == SDI12_MEAS_CONCURRENT) {
-            uint16_t nn = n > 99 ? 99 : n;
-            snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
-                     "%c%03u%02u\r\n", ctx->address, ttt, nn);
-            ctx->state = (ttt > 0) ? SDI12_STATE_MEASURING_C : SDI12_STATE_DATA_READY;
-        } else if (type == SDI12_MEAS_HIGHVOL_ASCII || type == SDI12_MEAS_HIGHVOL_BINARY) {
-            snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
-                     "%c%03u%03u\r\n", ctx->address, ttt, (unsigned)n);
+        } else {
             ctx->state = (ttt > 0) ? SDI12_STATE_MEASURING_C : SDI12_STATE_DATA_READY;
         }
 
         if (ttt == 0) {
             /* Synchronous — read now */
-            read_group_sync(ctx, group);
+            load_group(ctx, group);
         } else {
             ctx->data_available = false;
         }
     } else {
         /* No async callback — synchronous measurement (ttt = 0) */
-        read_group_sync(ctx, group);
-
-        if (type == SDI12_MEAS_STANDARD || type == SDI12_MEAS_VERIFICATION) {
-            snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
-                     "%c000%u\r\n", ctx->address, n > 9 ? 9 : n);
-        } else if (type == SDI12_MEAS_CONCURRENT) {
-            snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
-                     "%c000%02u\r\n", ctx->address, n > 99 ? 99 : (int)n);
-        } else {
-            snprintf(ctx->resp_buf, sizeof(ctx->resp_buf),
-                     "%c000%03u\r\n", ctx->address, (unsigned)n);
-        }
+        load_group(ctx, group);
+        format_meas_reply(ctx, type, 0, n);
         ctx->state = SDI12_STATE_DATA_READY;
     }
 
@@ -273,19 +909,14 @@ static sdi12_err_t handle_measurement(sdi12_sensor_ctx_t *ctx,
 static sdi12_err_t handle_send_binary_data(sdi12_sensor_ctx_t *ctx,
                                             uint16_t page)
 {
-    char *pkt = ctx->resp_buf;
+    if (ctx->hist_download && ctx->pending_meas_type == SDI12_MEAS_HIGHVOL_BINARY) {
+        send_history_binary_page(ctx, page);
+        return SDI12_OK;
+    }
 
     if (!ctx->data_available || ctx->cb.format_binary_page == NULL) {
         /* Empty binary packet: addr + 0x0000 + 0x00 + CRC(2) = 6 bytes */
-        pkt[0] = ctx->address;
-        pkt[1] = 0x00;  /* pkt_size LSB */
-        pkt[2] = 0x00;  /* pkt_size MSB */
-        pkt[3] = 0x00;  /* type = invalid */
-        uint16_t crc = sdi12_crc16(pkt, 4);
-        pkt[4] = (char)(crc & 0xFF);
-        pkt[5] = (char)((crc >> 8) & 0xFF);
-        ctx->resp_len = 6;
-        send_response(ctx);
+        send_binary_packet(ctx, SDI12_BINTYPE_INVALID, NULL, 0);
         return SDI12_OK;
     }
 
@@ -296,50 +927,34 @@ static sdi12_err_t handle_send_binary_data(sdi12_sensor_ctx_t *ctx,
      *   returns number of bytes written starting at buf[1] (type + payload)
      */
     char tmpbuf[SDI12_MAX_RESPONSE_LEN];
+    sdi12_value_t vals[SDI12_MAX_PARAMS];
+    cache_values(ctx, vals);
     tmpbuf[0] = ctx->address;
     size_t cb_bytes = ctx->cb.format_binary_page(
-        page, ctx->data_cache, ctx->data_cache_count,
+        page, vals, ctx->data_cache_count,
         tmpbuf, sizeof(tmpbuf), ctx->cb.user_data);
 
     if (cb_bytes == 0) {
         /* Empty page */
-        pkt[0] = ctx->address;
-        pkt[1] = 0x00;
-        pkt[2] = 0x00;
-        pkt[3] = 0x00;
-        uint16_t crc = sdi12_crc16(pkt, 4);
-        pkt[4] = (char)(crc & 0xFF);
-        pkt[5] = (char)((crc >> 8) & 0xFF);
-        ctx->resp_len = 6;
-        send_response(ctx);
+        send_binary_packet(ctx, SDI12_BINTYPE_INVALID, NULL, 0);
         return SDI12_OK;
     }
 
     /* cb_bytes = type(1) + raw_data(N), so payload_size = cb_bytes - 1 */
-    uint8_t data_type = (uint8_t)tmpbuf[1];
-    uint16_t payload_size = (uint16_t)(cb_bytes - 1);
-
-    /* Build binary packet: addr + pkt_size(2 LE) + type + payload + CRC(2 LE) */
-    pkt[0] = ctx->address;
-    pkt[1] = (char)(payload_size & 0xFF);
-    pkt[2] = (char)((payload_size >> 8) & 0xFF);
-    pkt[3] = (char)data_type;
-    if (payload_size > 0)
-        memcpy(pkt + 4, tmpbuf + 2, payload_size);
-
-    size_t data_end = 4 + (size_t)payload_size;
-    uint16_t crc = sdi12_crc16(pkt, data_end);
-    pkt[data_end]     = (char)(crc & 0xFF);
-    pkt[data_end + 1] = (char)((crc >> 8) & 0xFF);
-
-    ctx->resp_len = data_end + 2;
-    send_response(ctx);
+    send_binary_packet(ctx, (uint8_t)tmpbuf[1], tmpbuf + 2,
+                       (uint16_t)(cb_bytes - 1));
     return SDI12_OK;
 }
 
 /** Handle aD0!–aD9! — Send data. */
-static sdi12_err_t handle_send_data(sdi12_sensor_ctx_t *ctx, uint8_t page)
+static sdi12_err_t handle_send_data(sdi12_sensor_ctx_t *ctx, uint16_t page)
 {
+    if (ctx->hist_download && ctx->pending_meas_type == SDI12_MEAS_HIGHVOL_ASCII) {
+        format_history_page(ctx, page);
+        send_response(ctx);
+        return SDI12_OK;
+    }
+
     if (!ctx->data_available) {
         /* No data — respond with just address */
         if (ctx->crc_requested) {
@@ -355,9 +970,11 @@ static sdi12_err_t handle_send_data(sdi12_sensor_ctx_t *ctx, uint8_t page)
     /* High-volume binary: delegate to user callback if available */
     if (ctx->pending_meas_type == SDI12_MEAS_HIGHVOL_BINARY &&
         ctx->cb.format_binary_page != NULL) {
+        sdi12_value_t vals[SDI12_MAX_PARAMS];
+        cache_values(ctx, vals);
         ctx->resp_buf[0] = ctx->address;
         size_t payload = ctx->cb.format_binary_page(
-            page, ctx->data_cache, ctx->data_cache_count,
+            page, vals, ctx->data_cache_count,
             ctx->resp_buf, sizeof(ctx->resp_buf),
             ctx->cb.user_data);
         size_t pos = 1 + payload;  /* address + binary payload */
@@ -399,6 +1016,7 @@ static sdi12_err_t handle_continuous(sdi12_sensor_ctx_t *ctx,
 {
     ctx->crc_requested = with_crc;
     ctx->pending_meas_type = SDI12_MEAS_CONTINUOUS;
+    hist_end(ctx);
 
     /* For continuous, we read the specific parameter group and respond immediately */
     /* R0 = all group 0 params, R1 = group 1 params, etc. */
@@ -416,8 +1034,8 @@ static sdi12_err_t handle_continuous(sdi12_sensor_ctx_t *ctx,
         return SDI12_OK;
     }
 
-    /* Read all params in this group synchronously */
-    read_group_sync(ctx, index);
+    /* Serve from the background sample if fresh, else read synchronously */
+    load_group(ctx, index);
 
     /* Format as a single data response (like D0) */
     format_data_page(ctx, 0, SDI12_C_VALUES_MAX_CHARS);
@@ -618,6 +1236,11 @@ static sdi12_err_t handle_extended(sdi12_sensor_ctx_t *ctx,
     const char *xcmd_str = cmd + 2;
     size_t xcmd_len = len - 2;
 
+    /* Built-in: aXHIST<param>,<offset>,<count>! */
+    if (ctx->history_count > 0 && xcmd_len >= 4 && memcmp(xcmd_str, "HIST", 4) == 0) {
+        return handle_history_select(ctx, xcmd_str + 4, xcmd_len - 4);
+    }
+
     /* Search registered extended command handlers */
     for (uint8_t i = 0; i < ctx->xcmd_count; i++) {
         if (!ctx->xcmds[i].active) continue;
@@ -711,6 +1334,53 @@ sdi12_err_t sdi12_sensor_register_param(sdi12_sensor_ctx_t *ctx,
     return SDI12_OK;
 }
 
+sdi12_err_t sdi12_sensor_register_stats(sdi12_sensor_ctx_t *ctx,
+                                         uint8_t group,
+                                         uint8_t source_param,
+                                         uint8_t stats_mask,
+                                         uint32_t period_ms)
+{
+    static const uint8_t order[] = {
+        SDI12_STAT_MEAN, SDI12_STAT_MIN, SDI12_STAT_MAX,
+        SDI12_STAT_STDDEV, SDI12_STAT_COUNT
+    };
+
+    if (!ctx) return SDI12_ERR_INVALID_COMMAND;
+    if (group >= SDI12_MAX_MEAS_GROUPS) return SDI12_ERR_INVALID_COMMAND;
+    if (source_param >= ctx->param_count) return SDI12_ERR_INVALID_COMMAND;
+    if (ctx->params[source_param].stats_slot) return SDI12_ERR_INVALID_COMMAND;
+    if (stats_mask == 0 || (stats_mask & ~0x1Fu)) return SDI12_ERR_INVALID_COMMAND;
+
+    uint8_t needed = 0;
+    for (uint8_t b = 0; b < sizeof(order); b++) {
+        if (stats_mask & order[b]) needed++;
+    }
+    if (ctx->stats_count >= SDI12_MAX_STATS) return SDI12_ERR_PARAM_LIMIT;
+    if (ctx->param_count + needed > SDI12_MAX_PARAMS) return SDI12_ERR_PARAM_LIMIT;
+
+    sdi12_stats_t *st = &ctx->stats[ctx->stats_count];
+    memset(st, 0, sizeof(*st));
+    st->period_ms = period_ms;
+    st->source = source_param;
+    ctx->stats_count++;
+
+    const sdi12_param_reg_t *src = &ctx->params[source_param];
+    for (uint8_t b = 0; b < sizeof(order); b++) {
+        if (!(stats_mask & order[b])) continue;
+
+        sdi12_param_reg_t *p = &ctx->params[ctx->param_count];
+        memset(p, 0, sizeof(*p));
+        p->meta = src->meta;
+        p->group = group;
+        p->decimals = (order[b] == SDI12_STAT_COUNT) ? 0 : src->decimals;
+        p->stats_slot = ctx->stats_count;
+        p->stat = order[b];
+        p->active = true;
+        ctx->param_count++;
+    }
+    return SDI12_OK;
+}
+
 sdi12_err_t sdi12_sensor_register_xcmd(sdi12_sensor_ctx_t *ctx,
                                         const char *prefix,
                                         sdi12_xcmd_handler_fn handler)
@@ -822,14 +1492,15 @@ sdi12_err_t sdi12_sensor_process(sdi12_sensor_ctx_t *ctx,
             }
             /* aDn! — standard ASCII data */
             uint16_t page = 0;
-            for (size_t i = 2; i < cmdlen; i++) {
+            for (size_t i = 2; i < cmdlen && page < SDI12_MAX_HV_DATA_PAGES; i++) {
                 if (cmd[i] >= '0' && cmd[i] <= '9') {
                     page = page * 10 + (uint16_t)(cmd[i] - '0');
                 } else {
                     break;
                 }
             }
-            return handle_send_data(ctx, (uint8_t)(page > 255 ? 255 : page));
+            if (page >= SDI12_MAX_HV_DATA_PAGES) page = SDI12_MAX_HV_DATA_PAGES - 1;
+            return handle_send_data(ctx, page);
         }
         return SDI12_ERR_INVALID_COMMAND;
     }
@@ -894,30 +1565,81 @@ sdi12_err_t sdi12_sensor_measurement_done(sdi12_sensor_ctx_t *ctx,
 {
     if (!ctx) return SDI12_ERR_INVALID_COMMAND;
 
+    /* Completions arrive in start order: an outstanding prefetch's comes
+     * first, even with a bus measurement started since. It goes to the
+     * sample ring, with no service request. */
+    if (ctx->prefetch_pending) {
+        uint8_t g = ctx->prefetch_group;
+        sample_group(ctx, g, values, count);
+        ctx->predictors[g].state = SDI12_PREDICT_READY;
+        ctx->prefetch_pending = false;
+        return SDI12_OK;
+    }
+
+    /* A shared acquisition completes only through sdi12_sensor_shared_done() */
+    if (shared_awaited(ctx)) {
+        return SDI12_ERR_INVALID_COMMAND;
+    }
+
     /* Store the values in the cache */
     uint8_t n = count;
     if (n > SDI12_MAX_PARAMS) n = SDI12_MAX_PARAMS;
-    memcpy(ctx->data_cache, values, n * sizeof(sdi12_value_t));
+    for (uint8_t i = 0; i < n; i++) {
+        ctx->data_cache[i] = sdi12_decimal_from_value(values[i]);
+    }
     ctx->data_cache_count = n;
     ctx->data_available = true;
 
-    /* Send service request for standard/verification measurements only */
-    ctx->resp_len = 0;  /* text response — strlen is safe */
-    if (ctx->state == SDI12_STATE_MEASURING) {
-        /* Standard M/V — service request required */
-        snprintf(ctx->resp_buf, sizeof(ctx->resp_buf), "%c\r\n", ctx->address);
+    finish_measurement(ctx);
+    return SDI12_OK;
+}
 
-        if (ctx->cb.service_request) {
-            ctx->cb.service_request(ctx->cb.user_data);
-        } else {
-            send_response(ctx);
+sdi12_err_t sdi12_sensor_measurement_done_decimal(sdi12_sensor_ctx_t *ctx,
+                                                   const sdi12_decimal_t *values,
+                                                   uint8_t count)
+{
+    if (!ctx || (!values && count)) return SDI12_ERR_INVALID_COMMAND;
+
+    uint8_t n = count;
+    if (n > SDI12_MAX_PARAMS) n = SDI12_MAX_PARAMS;
+
+    /* A pre-measurement goes to the (float) sample ring */
+    if (ctx->prefetch_pending) {
+        sdi12_value_t vals[SDI12_MAX_PARAMS];
+        for (uint8_t i = 0; i < n; i++) {
+            vals[i].value = sdi12_decimal_to_float(values[i]);
+            vals[i].decimals = values[i].decimals;
         }
-        ctx->state = SDI12_STATE_DATA_READY;
-    } else if (ctx->state == SDI12_STATE_MEASURING_C) {
-        /* Concurrent — NO service request per spec */
-        ctx->state = SDI12_STATE_DATA_READY;
+        return sdi12_sensor_measurement_done(ctx, vals, n);
+    }
+
+    if (shared_awaited(ctx)) {
+        return SDI12_ERR_INVALID_COMMAND;
     }
 
+    if (n) memcpy(ctx->data_cache, values, n * sizeof(sdi12_decimal_t));
+    ctx->data_cache_count = n;
+    ctx->data_available = true;
+
+    finish_measurement(ctx);
+    return SDI12_OK;
+}
+
+sdi12_err_t sdi12_sensor_shared_done(sdi12_sensor_ctx_t *ctx,
+                                     const sdi12_value_t *params,
+                                     uint8_t count)
+{
+    if (!ctx || !params) return SDI12_ERR_INVALID_COMMAND;
+    if (!ctx->shared_pending) return SDI12_ERR_INVALID_COMMAND;
+
+    ctx->shared_pending = false;
+    shared_publish(ctx, params, count);
+
+    if (ctx->state == SDI12_STATE_MEASURING ||
+        ctx->state == SDI12_STATE_MEASURING_C) {
+        load_sample(ctx, ctx->pending_meas_group);
+        finish_measurement(ctx);
+    }
     return SDI12_OK;
 }
 
@@ -931,7 +1653,10 @@ void sdi12_sensor_break(sdi12_sensor_ctx_t *ctx)
         ctx->data_available = false;
         ctx->data_cache_count = 0;
     }
+    ctx->shared_pending = false;
 
+    /* A history selection survives: the master breaks again after 87 ms
+     * of idle, possibly mid-download */
     ctx->state = SDI12_STATE_READY;
 }
 
@@ -940,3 +1665,119 @@ uint8_t sdi12_sensor_group_count(const sdi12_sensor_ctx_t *ctx, uint8_t group)
     if (!ctx) return 0;
     return count_group(ctx, group);
 }
+
+sdi12_err_t sdi12_sensor_set_sampler(sdi12_sensor_ctx_t *ctx,
+                                      uint8_t group,
+                                      uint32_t period_ms,
+                                      uint32_t max_age_ms)
+{
+    if (!ctx) return SDI12_ERR_INVALID_COMMAND;
+    if (group >= SDI12_MAX_MEAS_GROUPS) return SDI12_ERR_INVALID_COMMAND;
+
+    sdi12_sampler_t *s = &ctx->samplers[group];
+    memset(s, 0, sizeof(*s));
+    s->period_ms = period_ms;
+    s->max_age_ms = max_age_ms;
+    return SDI12_OK;
+}
+
+void sdi12_sensor_tick(sdi12_sensor_ctx_t *ctx, uint32_t now_ms)
+{
+    if (!ctx) return;
+
+    ctx->now_ms = now_ms;
+    ctx->ticked = true;
+
+    for (uint8_t i = 0; i < ctx->stats_count; i++) {
+        sdi12_stats_t *st = &ctx->stats[i];
+        if (st->sampled && (uint32_t)(now_ms - st->last_ms) < st->period_ms) continue;
+        stats_add(st, ctx->cb.read_param(st->source, ctx->cb.user_data).value);
+        st->last_ms = now_ms;
+        st->sampled = true;
+    }
+
+    /* An abandoned download must not hold the ring forever */
+    if (ctx->hist_sel && (uint32_t)(now_ms - ctx->hist_touch_ms) >= SDI12_HISTORY_HOLD_MS) {
+        hist_end(ctx);
+    }
+
+    for (uint8_t i = 0; i < ctx->history_count; i++) {
+        sdi12_history_t *h = &ctx->history[i];
+        if (h->sampled && (uint32_t)(now_ms - h->last_ms) < h->period_ms) continue;
+        h->last_ms = now_ms;
+        h->sampled = true;
+
+        /* Overwrite a record of the open selection only once it is read */
+        if (ctx->hist_sel == i + 1u &&
+            (uint16_t)((h->head + h->capacity - hist_sel_first(ctx, h)) % h->capacity)
+                < ctx->hist_sel_count) {
+            if (!ctx->hist_served) {
+                h->dropped++;
+                continue;
+            }
+            hist_end(ctx);
+        }
+
+        sdi12_history_rec_t *r = &h->recs[h->head];
+        r->t_ms = now_ms;
+        r->v = param_value(ctx, h->param);
+        h->head = (uint16_t)((h->head + 1u) % h->capacity);
+        if (h->count < h->capacity) h->count++;
+    }
+
+    for (uint8_t g = 0; g < SDI12_MAX_MEAS_GROUPS; g++) {
+        const sdi12_sampler_t *s = &ctx->samplers[g];
+        if (s->period_ms == 0) continue;
+        if (s->valid && (uint32_t)(now_ms - s->sampled_at_ms) < s->period_ms) continue;
+        sample_group(ctx, g, NULL, 0);
+    }
+
+    if (ctx->predict_enabled) predict_tick(ctx);
+}
+
+void sdi12_sensor_set_prediction(sdi12_sensor_ctx_t *ctx,
+                                  bool enable, uint32_t guard_ms)
+{
+    if (!ctx) return;
+
+    /* A prefetch that cannot be stopped still completes into its group */
+    predict_cancel(ctx);
+    memset(ctx->predictors, 0, sizeof(ctx->predictors));
+    memset(&ctx->predict_stats, 0, sizeof(ctx->predict_stats));
+    ctx->predict_guard_ms = guard_ms;
+    ctx->predict_enabled = enable;
+}
+
+sdi12_err_t sdi12_sensor_set_shared_acquisition(sdi12_sensor_ctx_t *ctx,
+                                                 uint16_t group_mask,
+                                                 uint32_t validity_ms)
+{
+    if (!ctx) return SDI12_ERR_INVALID_COMMAND;
+    if (group_mask >> SDI12_MAX_MEAS_GROUPS) return SDI12_ERR_INVALID_COMMAND;
+
+    ctx->shared_mask = group_mask;
+    ctx->shared_validity_ms = validity_ms;
+    ctx->shared_pending = false;
+    ctx->shared_valid = false;
+    return SDI12_OK;
+}
+
+sdi12_err_t sdi12_sensor_attach_history(sdi12_sensor_ctx_t *ctx,
+                                         uint8_t param,
+                                         sdi12_history_rec_t *recs,
+                                         uint16_t capacity,
+                                         uint32_t period_ms)
+{
+    if (!ctx || !recs || capacity == 0) return SDI12_ERR_INVALID_COMMAND;
+    if (param >= ctx->param_count) return SDI12_ERR_INVALID_COMMAND;
+    if (ctx->history_count >= SDI12_MAX_HISTORY) return SDI12_ERR_PARAM_LIMIT;
+
+    sdi12_history_t *h = &ctx->history[ctx->history_count];
+    memset(h, 0, sizeof(*h));
+    h->recs = recs;
+    h->capacity = capacity;
+    h->period_ms = period_ms;
+    h->param = param;
+    ctx->history_count++;
+    return SDI12_OK;
+}
@@ -13,6 +13,15 @@
  *   4. In your serial RX handler, pass received commands to sdi12_sensor_process().
  *   5. When an async measurement completes, call sdi12_sensor_measurement_done().
  *   6. On detecting a break signal, call sdi12_sensor_break().
+ *   7. Optionally, enable background sampling with sdi12_sensor_set_sampler()
+ *      and call sdi12_sensor_tick() from your main loop.
+ *   8. Optionally, enable sdi12_sensor_set_prediction() to pre-measure ahead
+ *      of a datalogger that polls on a fixed schedule.
+ *   9. If one hardware cycle converts every group, enable
+ *      sdi12_sensor_set_shared_acquisition() and complete it with
+ *      sdi12_sensor_shared_done().
+ *  10. Register interval statistics with sdi12_sensor_register_stats().
+ *  11. Attach sample history rings with sdi12_sensor_attach_history().
  */
 #ifndef SDI12_SENSOR_H
 #define SDI12_SENSOR_H
@@ -45,7 +54,8 @@ typedef sdi12_value_t (*sdi12_read_param_fn)(uint8_t param_index, void *user_dat
  * begin measuring and call sdi12_sensor_measurement_done() when complete.
  * If NULL, measurements are assumed synchronous (ttt = 0).
  *
- * @param group      Measurement group index (0 = aM!/aC!, 1–9 = aM1!–aM9!, etc.)
+ * @param group      Measurement group index (0 = aM!/aC!, 1–9 = aM1!–aM9!, etc.),
+ *                   or SDI12_SHARED_GROUP for a shared acquisition.
  * @param type       Measurement type (standard, concurrent, etc.)
  * @param user_data  User pointer from callbacks.
  * @return Estimated time in seconds (0–999). Library uses this for ttt field.
@@ -54,6 +64,19 @@ typedef uint16_t (*sdi12_start_measurement_fn)(uint8_t group,
                                                 sdi12_meas_type_t type,
                                                 void *user_data);
 
+/**
+ * @brief Callback to abandon a running pre-measurement.
+ *
+ * Called when a bus measurement needs the hardware while a prediction
+ * prefetch (see sdi12_sensor_set_prediction()) is still running.
+ *
+ * @param group      Group the abandoned start_measurement was called with.
+ * @param user_data  User pointer from callbacks.
+ * @return true if the acquisition was stopped and will never complete,
+ *         false if its sdi12_sensor_measurement_done() is still coming.
+ */
+typedef bool (*sdi12_abort_measurement_fn)(uint8_t group, void *user_data);
+
 /**
  * @brief Callback to send a response string on the SDI-12 bus.
  *
@@ -161,6 +184,7 @@ typedef struct {
     sdi12_service_request_fn  service_request;  /**< Send service request. */
     sdi12_reset_fn            on_reset;         /**< Device reset hook. */
     sdi12_format_binary_fn    format_binary_page; /**< Binary HV data (NULL = unsupported). */
+    sdi12_abort_measurement_fn abort_measurement; /**< Stop a prefetch (NULL = let it finish). */
 
     void *user_data; /**< Passed to all callbacks. */
 } sdi12_sensor_callbacks_t;
@@ -176,6 +200,8 @@ typedef struct {
     sdi12_param_meta_t meta;    /**< SHEF code and units. */
     uint8_t group;              /**< Measurement group (0 = M/C, 1–9 = M1–M9/C1–C9). */
     uint8_t decimals;           /**< Default decimal places. */
+    uint8_t stats_slot;         /**< Accumulator index + 1 (0 = read via read_param). */
+    uint8_t stat;               /**< SDI12_STAT_* reported by a statistics param. */
     bool    active;             /**< Whether this slot is in use. */
 } sdi12_param_reg_t;
 
@@ -188,6 +214,117 @@ typedef struct {
     bool                 active;
 } sdi12_xcmd_reg_t;
 
+/**
+ * @brief Background sampler state for one measurement group.
+ *
+ * The sampler refreshes a group's values from sdi12_sensor_tick() so that
+ * aRn! and synchronous aM!/aC! can be answered from the latest sample
+ * instead of calling read_param inside the 15 ms response window.
+ */
+typedef struct {
+    uint32_t period_ms;     /**< Refresh period (0 = sampler disabled). */
+    uint32_t max_age_ms;    /**< Oldest sample still served (0 = no limit). */
+    uint32_t sampled_at_ms; /**< Tick time of the latest published sample. */
+    uint8_t  slot;          /**< Ring slot holding the latest sample. */
+    bool     valid;         /**< True once a sample has been published. */
+} sdi12_sampler_t;
+
+/** Statistics selectable in sdi12_sensor_register_stats() (bitmask). */
+#define SDI12_STAT_MEAN    0x01
+#define SDI12_STAT_MIN     0x02
+#define SDI12_STAT_MAX     0x04
+#define SDI12_STAT_STDDEV  0x08  /**< Sample standard deviation. */
+#define SDI12_STAT_COUNT   0x10  /**< Number of samples in the interval. */
+
+/**
+ * @brief Streaming (Welford) accumulator over one source parameter.
+ *
+ * Fed from sdi12_sensor_tick(); reset each time the interval is reported.
+ */
+typedef struct {
+    uint32_t period_ms;     /**< Sampling period of the source param. */
+    uint32_t last_ms;       /**< Tick time of the latest sample. */
+    uint32_t n;             /**< Samples in the current interval. */
+    float    mean;          /**< Running mean. */
+    float    m2;            /**< Sum of squared deviations from the mean. */
+    float    min;
+    float    max;
+    uint8_t  source;        /**< Param index that is sampled. */
+    bool     sampled;       /**< last_ms is valid. */
+} sdi12_stats_t;
+
+/** One timestamped history record (caller-provided storage). */
+typedef struct {
+    uint32_t      t_ms;     /**< Tick time the sample was taken. */
+    sdi12_value_t v;
+} sdi12_history_rec_t;
+
+/**
+ * @brief Sample history ring for one parameter.
+ *
+ * Records live in caller memory attached with sdi12_sensor_attach_history();
+ * the oldest record is overwritten when the ring is full.
+ */
+typedef struct {
+    sdi12_history_rec_t *recs;  /**< Caller-provided record array. */
+    uint32_t period_ms;         /**< Recording period. */
+    uint32_t last_ms;           /**< Tick time of the latest record. */
+    uint32_t dropped;           /**< Samples skipped to protect an unread selection. */
+    uint16_t capacity;
+    uint16_t head;              /**< Next record to write. */
+    uint16_t count;             /**< Records held (≤ capacity). */
+    uint8_t  param;             /**< Param index recorded. */
+    bool     sampled;           /**< last_ms is valid. */
+} sdi12_history_t;
+
+/** Most records one aXHIST selection can cover (two HA values each). */
+#define SDI12_HISTORY_MAX_SELECT 499
+
+/** An aXHIST selection with no download traffic for this long is closed. */
+#define SDI12_HISTORY_HOLD_MS 60000u
+
+/** Group index passed to start_measurement for a shared acquisition. */
+#define SDI12_SHARED_GROUP 0xFF
+
+/** Consecutive matching poll intervals required before pre-measuring. */
+#define SDI12_PREDICT_MIN_CONFIDENCE 2
+
+/** Poll jitter tolerated, as a fraction (1/n) of the learned interval. */
+#define SDI12_PREDICT_TOLERANCE_DIV 8
+
+/** Pre-measurement state for one measurement group. */
+typedef enum {
+    SDI12_PREDICT_IDLE = 0,  /**< Waiting for the next predicted poll. */
+    SDI12_PREDICT_PENDING,   /**< Acquisition started, values not yet in. */
+    SDI12_PREDICT_READY      /**< Values published to the sample ring. */
+} sdi12_predict_state_t;
+
+/**
+ * @brief Learned polling cadence for one measurement group.
+ *
+ * Updated on every aM!/aC! for the group; drives pre-measurement from
+ * sdi12_sensor_tick().
+ */
+typedef struct {
+    uint32_t last_poll_ms;  /**< Arrival time of the previous aM!/aC!. */
+    uint32_t interval_ms;   /**< Learned inter-arrival time (0 = unknown). */
+    uint32_t lead_ms;       /**< Acquisition time learned from the last ttt. */
+    uint32_t started_ms;    /**< When the current pre-measurement started. */
+    sdi12_meas_type_t type; /**< Command type of the last poll. */
+    uint8_t  confidence;    /**< Consecutive intervals matching the estimate. */
+    uint8_t  state;         /**< sdi12_predict_state_t. */
+    bool     seen;          /**< At least one poll observed. */
+} sdi12_predictor_t;
+
+/** Pre-measurement statistics (see sdi12_sensor_get_predict_stats()). */
+typedef struct {
+    uint32_t polls;       /**< aM!/aC! commands observed. */
+    uint32_t hits;        /**< Answered with ttt=000 from a pre-measurement. */
+    uint32_t late;        /**< Pre-measurement still running; adopted it. */
+    uint32_t misses;      /**< No usable pre-measurement. */
+    uint32_t prefetches;  /**< Pre-measurements started. */
+} sdi12_predict_stats_t;
+
 /* ────────────────────────────────────────────────────────────────────────── */
 /*  Sensor Context                                                           */
 /* ────────────────────────────────────────────────────────────────────────── */
@@ -219,10 +356,50 @@ typedef struct {
     bool               crc_requested;
 
     /* Measurement data cache */
-    sdi12_value_t      data_cache[SDI12_MAX_PARAMS];
+    sdi12_decimal_t    data_cache[SDI12_MAX_PARAMS];
     uint8_t            data_cache_count;
     bool               data_available;
 
+    /* Background sampler (indexed by group / parameter index) */
+    sdi12_sampler_t    samplers[SDI12_MAX_MEAS_GROUPS];
+    sdi12_value_t      sample_ring[SDI12_SAMPLE_SLOTS][SDI12_MAX_PARAMS];
+    uint32_t           now_ms;    /**< Timestamp of the latest sdi12_sensor_tick(). */
+    bool               ticked;    /**< now_ms has been set by sdi12_sensor_tick(). */
+
+    /* Predictive pre-measurement */
+    sdi12_predictor_t  predictors[SDI12_MAX_MEAS_GROUPS];
+    sdi12_predict_stats_t predict_stats;
+    uint32_t           predict_guard_ms;
+    uint8_t            prefetch_group;    /**< Group of the in-flight prefetch. */
+    bool               prefetch_pending;  /**< start_measurement issued by prediction. */
+    bool               predict_enabled;
+
+    /* Streaming statistics */
+    sdi12_stats_t      stats[SDI12_MAX_STATS];
+    uint8_t            stats_count;
+
+    /* Sample history */
+    sdi12_history_t    history[SDI12_MAX_HISTORY];
+    uint8_t            history_count;
+    uint8_t            hist_sel;        /**< Selected history + 1 (0 = none). */
+    uint16_t           hist_sel_newest; /**< Ring slot of the newest selected record. */
+    uint16_t           hist_sel_count;  /**< Records selected. */
+    uint32_t           hist_ref_ms;     /**< Ages are reported relative to this. */
+    bool               hist_download;   /**< aHA!/aHB! is serving the selection. */
+    bool               hist_served;     /**< The selection's last page has been sent. */
+    uint32_t           hist_touch_ms;   /**< Latest select or page served. */
+    uint16_t           hist_memo_page;  /**< Last HA page served... */
+    uint16_t           hist_memo_start; /**< ...and its first value index. */
+
+    /* Shared acquisition */
+    uint16_t           shared_mask;        /**< Bit n set = group n is covered. */
+    uint32_t           shared_validity_ms;
+    uint32_t           shared_started_ms;
+    uint16_t           shared_ttt;
+    uint32_t           shared_at_ms;       /**< Tick time of the latest snapshot. */
+    bool               shared_valid;       /**< shared_at_ms is usable. */
+    bool               shared_pending;     /**< Waiting for sdi12_sensor_shared_done(). */
+
     /* Response buffer */
     char               resp_buf[SDI12_MAX_RESPONSE_LEN];
     size_t             resp_len;  /**< Actual response length (avoids strlen on binary). */
@@ -299,12 +476,29 @@ sdi12_err_t sdi12_sensor_process(sdi12_sensor_ctx_t *ctx,
  * @param ctx     Sensor context.
  * @param values  Array of measurement values.
  * @param count   Number of values.
- * @return SDI12_OK on success.
+ * @return SDI12_OK on success, SDI12_ERR_INVALID_COMMAND if the running
+ *         command waits for a shared acquisition (see
+ *         sdi12_sensor_shared_done()).
  */
 sdi12_err_t sdi12_sensor_measurement_done(sdi12_sensor_ctx_t *ctx,
                                            const sdi12_value_t *values,
                                            uint8_t count);
 
+/**
+ * @brief Like sdi12_sensor_measurement_done(), with exact decimal values.
+ *
+ * The values reach aD0! digit for digit ({1234567, 3} → "+1234.567") and
+ * no float arithmetic runs on the way, which suits MCUs without an FPU.
+ *
+ * @param ctx     Sensor context.
+ * @param values  Array of measurement values.
+ * @param count   Number of values.
+ * @return SDI12_OK on success.
+ */
+sdi12_err_t sdi12_sensor_measurement_done_decimal(sdi12_sensor_ctx_t *ctx,
+                                                   const sdi12_decimal_t *values,
+                                                   uint8_t count);
+
 /**
  * @brief Notify the library that a break signal was detected.
  *
@@ -316,6 +510,202 @@ sdi12_err_t sdi12_sensor_measurement_done(sdi12_sensor_ctx_t *ctx,
  */
 void sdi12_sensor_break(sdi12_sensor_ctx_t *ctx);
 
+/**
+ * @brief Configure the background sampler for a measurement group.
+ *
+ * Once enabled, sdi12_sensor_tick() reads every parameter of the group
+ * each `period_ms` and publishes the values to a small ring. aRn! and
+ * synchronous aM!/aC!/aV! for that group are then answered from the latest
+ * sample without calling read_param, provided the sample is no older than
+ * `max_age_ms`. Older samples fall back to a synchronous read.
+ *
+ * Sample age is measured against the timestamp passed to the most recent
+ * sdi12_sensor_tick() call.
+ *
+ * @param ctx         Sensor context.
+ * @param group       Measurement group (0–9).
+ * @param period_ms   Refresh period in milliseconds (0 = disable).
+ * @param max_age_ms  Maximum age of a served sample (0 = no limit).
+ * @return SDI12_OK on success, SDI12_ERR_INVALID_COMMAND for a bad group.
+ */
+sdi12_err_t sdi12_sensor_set_sampler(sdi12_sensor_ctx_t *ctx,
+                                      uint8_t group,
+                                      uint32_t period_ms,
+                                      uint32_t max_age_ms);
+
+/**
+ * @brief Advance time-based sensor work (background sampling).
+ *
+ * Call this regularly from your main loop — never from an ISR that may
+ * interrupt sdi12_sensor_process(). Groups whose sampling period has
+ * elapsed are re-read and published atomically to the sample ring.
+ *
+ * @param ctx     Sensor context.
+ * @param now_ms  Monotonic millisecond timestamp (wrap-around safe).
+ */
+void sdi12_sensor_tick(sdi12_sensor_ctx_t *ctx, uint32_t now_ms);
+
+/**
+ * @brief Aggregate a parameter over the logger's polling interval.
+ *
+ * Samples `source_param` every `period_ms` from sdi12_sensor_tick() into a
+ * Welford accumulator and registers one read-only param in `group` per
+ * bit of `stats_mask`, in the order mean, min, max, stddev, count. The
+ * new params take the source's SHEF code, units and decimals.
+ *
+ * aMn!/aCn!/aV! for a group holding statistics are answered synchronously
+ * (ttt=000) and start a new interval; aRn! reports the interval so far
+ * without resetting it. An empty interval reports 0.
+ *
+ * @param ctx           Sensor context.
+ * @param group         Measurement group for the statistics (0–9).
+ * @param source_param  Registered param to sample.
+ * @param stats_mask    SDI12_STAT_* bits.
+ * @param period_ms     Sampling period.
+ * @return SDI12_OK, SDI12_ERR_PARAM_LIMIT if the params or accumulators
+ *         run out, SDI12_ERR_INVALID_COMMAND on bad arguments.
+ */
+sdi12_err_t sdi12_sensor_register_stats(sdi12_sensor_ctx_t *ctx,
+                                         uint8_t group,
+                                         uint8_t source_param,
+                                         uint8_t stats_mask,
+                                         uint32_t period_ms);
+
+/**
+ * @brief Keep a timestamped history of a parameter for bulk download.
+ *
+ * Records param_value every `period_ms` from sdi12_sensor_tick() into a
+ * ring in caller memory. A logger recovering from an outage selects a
+ * range with the built-in extended command
+ *
+ *     aXHIST<param>,<offset>,<count>!   → a+<selected>
+ *
+ * where offset counts back from the newest record, then downloads it with
+ * aHA! (D pages of age/value pairs, age in seconds) or aHB! (DB pages of
+ * FLOAT32 age/value pairs). The selection stays open, across breaks,
+ * until the next M/C/V/R or aXHIST command, or until
+ * SDI12_HISTORY_HOLD_MS pass without a select or page request. Recording
+ * goes on meanwhile into the free part of the ring. Once the ring reaches
+ * the selection, a selection whose last page has been served is closed
+ * and overwritten; otherwise the sample is skipped and counted in
+ * `dropped`, so at most a hold time of samples is lost.
+ *
+ * @param ctx        Sensor context.
+ * @param param      Registered param index to record.
+ * @param recs       Caller-provided record array (must outlive ctx).
+ * @param capacity   Number of records in recs.
+ * @param period_ms  Recording period.
+ * @return SDI12_OK, SDI12_ERR_PARAM_LIMIT if SDI12_MAX_HISTORY rings are
+ *         attached, SDI12_ERR_INVALID_COMMAND on bad arguments.
+ */
+sdi12_err_t sdi12_sensor_attach_history(sdi12_sensor_ctx_t *ctx,
+                                         uint8_t param,
+                                         sdi12_history_rec_t *recs,
+                                         uint16_t capacity,
+                                         uint32_t period_ms);
+
+/**
+ * @brief Acquire several measurement groups in one hardware cycle.
+ *
+ * For hardware that converts every channel at once. An aMn!/aCn! for a
+ * covered group with no recent snapshot calls start_measurement once with
+ * SDI12_SHARED_GROUP; the result populates every covered group. Further
+ * aMn!/aCn! for covered groups within validity_ms answer ttt=000 from
+ * that snapshot.
+ *
+ * Complete an asynchronous shared acquisition with
+ * sdi12_sensor_shared_done(). Without start_measurement (or with ttt=0)
+ * all covered params are read via read_param immediately.
+ *
+ * Snapshot age is measured on the sdi12_sensor_tick() clock, so tick()
+ * must run regularly. A snapshot taken before the first tick is never
+ * reused, and validity_ms = 0 means every command acquires.
+ *
+ * The snapshot is published into the same per-group sample slots as the
+ * background sampler (sdi12_sensor_set_sampler()) and predictive
+ * pre-measurement. validity_ms counts from the shared acquisition only.
+ * While it runs, a covered group is answered with its newest published
+ * sample, which may be a later background sample or prefetch of that
+ * group. Commands for covered groups are served here before prediction
+ * sees them, so those groups are never prefetched. A shared snapshot also
+ * counts as a fresh sample for sampler-served aR!.
+ *
+ * A prefetch of an uncovered group running when a shared acquisition
+ * starts is offered to abort_measurement first. If it keeps running, its
+ * result still arrives through sdi12_sensor_measurement_done() and fills
+ * only its own group. The shared result arrives only through
+ * sdi12_sensor_shared_done(); measurement_done() is refused while it is
+ * pending for the current command.
+ *
+ * @param ctx          Sensor context.
+ * @param group_mask   Bit n set = group n (0–9) shares the acquisition.
+ *                     0 disables shared acquisition.
+ * @param validity_ms  How long a snapshot answers later commands.
+ * @return SDI12_OK, or SDI12_ERR_INVALID_COMMAND for bits above group 9.
+ */
+sdi12_err_t sdi12_sensor_set_shared_acquisition(sdi12_sensor_ctx_t *ctx,
+                                                 uint16_t group_mask,
+                                                 uint32_t validity_ms);
+
+/**
+ * @brief Complete a shared acquisition.
+ *
+ * Publishes the snapshot to every covered group and finishes the pending
+ * measurement like sdi12_sensor_measurement_done() (service request for
+ * M/V commands).
+ *
+ * @param ctx     Sensor context.
+ * @param params  Values indexed by param index (as registered).
+ * @param count   Number of entries in params.
+ * @return SDI12_OK, or SDI12_ERR_INVALID_COMMAND if none is pending.
+ */
+sdi12_err_t sdi12_sensor_shared_done(sdi12_sensor_ctx_t *ctx,
+                                     const sdi12_value_t *params,
+                                     uint8_t count);
+
+/**
+ * @brief Enable or disable predictive pre-measurement.
+ *
+ * When enabled, the sensor learns the interval between successive aM!/aC!
+ * commands for each group. Once the cadence is stable, sdi12_sensor_tick()
+ * starts the acquisition `lead + guard_ms` before the next expected poll,
+ * where `lead` is the ttt the platform returned for the previous
+ * measurement. When the poll lands the sensor answers with ttt=000 and the
+ * prefetched values are available immediately through aD0!.
+ *
+ * Pre-measurements use the same start_measurement / measurement_done
+ * callbacks as normal ones. While a prefetch is outstanding, the next
+ * sdi12_sensor_measurement_done() is its result: it goes to that group's
+ * sample ring and sends no service request. If the poll arrives while the
+ * pre-measurement is still running, the sensor replies with the remaining
+ * time and completes it as a normal measurement. Sensors without
+ * start_measurement read params synchronously.
+ *
+ * A command for another group that needs the hardware meanwhile first
+ * offers the prefetch to abort_measurement. If that callback is NULL or
+ * returns false, the prefetch keeps running and the platform must deliver
+ * completions in start order: the prefetch's first, then the new
+ * measurement's. A platform that restarts its hardware on every
+ * start_measurement must therefore provide abort_measurement.
+ *
+ * @param ctx       Sensor context.
+ * @param enable    True to enable prediction.
+ * @param guard_ms  Extra margin added to the learned acquisition time.
+ */
+void sdi12_sensor_set_prediction(sdi12_sensor_ctx_t *ctx,
+                                  bool enable, uint32_t guard_ms);
+
+/**
+ * @brief Get pre-measurement statistics (hit rate = hits / polls).
+ *
+ * @param ctx  Sensor context.
+ * @return Pointer to the statistics held in the context.
+ */
+static inline const sdi12_predict_stats_t *
+sdi12_sensor_get_predict_stats(const sdi12_sensor_ctx_t *ctx) {
+    return &ctx->predict_stats;
+}
+
 /**
  * @brief Get the current sensor address.
  *
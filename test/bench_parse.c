@@ -0,0 +1,132 @@
+/**
+ * @file bench_parse.c
+ * @brief Benchmark for sdi12_master_parse_data_values().
+ *
+ * Builds a corpus of D-page bodies shaped like real logger traffic
+ * (temperatures, pressures, conductivities, counters, battery voltages)
+ * and times the library's single-pass scanner against the previous
+ * strtod()-based implementation, checking that both agree bit for bit.
+ *
+ * Not part of the test suite:  make bench
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sdi12.h"
+#include "sdi12_master.h"
+
+#define CORPUS_PAGES 20000
+#define ROUNDS       50
+
+static char     corpus[CORPUS_PAGES][SDI12_C_VALUES_MAX_CHARS + 1];
+static size_t   corpus_len[CORPUS_PAGES];
+static uint32_t seed = 2024u;
+
+static uint32_t rnd(uint32_t n)
+{
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 8) % n;
+}
+
+/** One value in the style of a common sensor channel. */
+static int gen_value(char *out, size_t size)
+{
+    switch (rnd(5)) {
+    case 0:  return snprintf(out, size, "%+.2f", (double)rnd(8000) / 100.0 - 30.0);
+    case 1:  return snprintf(out, size, "%+.1f", 950.0 + (double)rnd(1000) / 10.0);
+    case 2:  return snprintf(out, size, "%+.5f", (double)rnd(200000) / 100000.0);
+    case 3:  return snprintf(out, size, "+%u", (unsigned)rnd(100000));
+    default: return snprintf(out, size, "%+.3f", 11.0 + (double)rnd(3000) / 1000.0);
+    }
+}
+
+/** The parser as it was: copy, strtod(), narrow, memchr() for the point. */
+static uint8_t parse_strtod(const char *s, size_t len, sdi12_value_t *values,
+                            uint8_t max)
+{
+    uint8_t count = 0;
+    size_t pos = 0;
+    while (pos < len && count < max) {
+        if (s[pos] != '+' && s[pos] != '-') { pos++; continue; }
+        size_t start = pos++;
+        while (pos < len && ((s[pos] >= '0' && s[pos] <= '9') || s[pos] == '.')) pos++;
+        if (pos > start + 1) {
+            char vbuf[SDI12_VALUE_MAX_CHARS + 1];
+            size_t vlen = pos - start;
+            if (vlen > SDI12_VALUE_MAX_CHARS) vlen = SDI12_VALUE_MAX_CHARS;
+            memcpy(vbuf, s + start, vlen);
+            vbuf[vlen] = '\0';
+            values[count].value = (float)strtod(vbuf, NULL);
+            const char *dot = (const char *)memchr(vbuf, '.', vlen);
+            values[count].decimals = dot ? (uint8_t)(vlen - (size_t)(dot - vbuf) - 1) : 0;
+            count++;
+        }
+    }
+    return count;
+}
+
+int main(void)
+{
+    size_t total_values = 0;
+    for (int p = 0; p < CORPUS_PAGES; p++) {
+        size_t len = 0;
+        uint32_t n = 1 + rnd(9);
+        for (uint32_t i = 0; i < n; i++) {
+            char v[16];
+            int w = gen_value(v, sizeof(v));
+            if (w <= 0 || len + (size_t)w > SDI12_C_VALUES_MAX_CHARS) break;
+            memcpy(corpus[p] + len, v, (size_t)w);
+            len += (size_t)w;
+            total_values++;
+        }
+        corpus[p][len] = '\0';
+        corpus_len[p] = len;
+    }
+
+    /* Agreement */
+    sdi12_value_t a[SDI12_MAX_VALUES], b[SDI12_MAX_VALUES];
+    size_t mismatches = 0;
+    for (int p = 0; p < CORPUS_PAGES; p++) {
+        uint8_t na = 0;
+        sdi12_master_parse_data_values(corpus[p], corpus_len[p], a, SDI12_MAX_VALUES, &na, false);
+        uint8_t nb = parse_strtod(corpus[p], corpus_len[p], b, SDI12_MAX_VALUES);
+        if (na != nb) { mismatches++; continue; }
+        for (uint8_t i = 0; i < na; i++) {
+            if (memcmp(&a[i].value, &b[i].value, sizeof(float)) != 0 ||
+                a[i].decimals != b[i].decimals) {
+                mismatches++;
+            }
+        }
+    }
+
+    /* Timing */
+    volatile float sink = 0.0f;
+    clock_t t0 = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int p = 0; p < CORPUS_PAGES; p++) {
+            uint8_t n = 0;
+            sdi12_master_parse_data_values(corpus[p], corpus_len[p], a, SDI12_MAX_VALUES, &n, false);
+            sink += a[0].value;
+        }
+    }
+    clock_t t1 = clock();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int p = 0; p < CORPUS_PAGES; p++) {
+            parse_strtod(corpus[p], corpus_len[p], b, SDI12_MAX_VALUES);
+            sink += b[0].value;
+        }
+    }
+    clock_t t2 = clock();
+    (void)sink;
+
+    double n = (double)total_values * ROUNDS;
+    double scan_ns = (double)(t1 - t0) / CLOCKS_PER_SEC * 1e9 / n;
+    double strtod_ns = (double)(t2 - t1) / CLOCKS_PER_SEC * 1e9 / n;
+    printf("corpus: %d pages, %lu values, %lu mismatches\n",
+           CORPUS_PAGES, (unsigned long)total_values, (unsigned long)mismatches);
+    printf("scanner: %6.1f ns/value\n", scan_ns);
+    printf("strtod:  %6.1f ns/value (%.1fx)\n", strtod_ns,
+           scan_ns > 0.0 ? strtod_ns / scan_ns : 0.0);
+    return mismatches ? 1 : 0;
+}
@@ -6,6 +6,7 @@
  *   - Valid addresses: '0'-'9', 'A'-'Z', 'a'-'z'
  *   - Invalid addresses: special chars, control chars, space, punctuation
  *   - Boundary characters
+ *   - Dense address index round trip
  */
 #include "sdi12_test.h"
 #include "sdi12.h"
@@ -68,3 +69,18 @@ void test_total_valid_count(void)
     }
     TEST_ASSERT_EQUAL_INT(62, count); /* 10 + 26 + 26 = 62 per spec */
 }
+
+void test_address_index_roundtrip(void)
+{
+    for (int i = 0; i < 62; i++) {
+        char c = sdi12_address_from_index(i);
+        TEST_ASSERT_TRUE(sdi12_valid_address(c));
+        TEST_ASSERT_EQUAL_INT(i, sdi12_address_index(c));
+    }
+    TEST_ASSERT_EQUAL_INT(0, sdi12_address_index('0'));
+    TEST_ASSERT_EQUAL_INT(10, sdi12_address_index('A'));
+    TEST_ASSERT_EQUAL_INT(61, sdi12_address_index('z'));
+    TEST_ASSERT_EQUAL_INT(-1, sdi12_address_index('?'));
+    TEST_ASSERT_EQUAL('\0', sdi12_address_from_index(62));
+    TEST_ASSERT_EQUAL('\0', sdi12_address_from_index(-1));
+}
@@ -4,6 +4,7 @@
  *
  * Tests cover:
  *   - Known CRC-16 vectors
+ *   - Incremental CRC over split messages
  *   - ASCII encoding of CRC (3-char format per §4.4.12.2)
  *   - CRC append to response buffers
  *   - CRC verification on received strings
@@ -46,6 +47,20 @@ void test_crc16_different_data_differs(void)
     TEST_ASSERT_NOT_EQUAL_HEX16(crc_a, crc_b);
 }
 
+void test_crc16_update_chained(void)
+{
+    const char *msg = "0+3.14+2.718+1.414";
+    size_t len = strlen(msg);
+    uint16_t whole = sdi12_crc16(msg, len);
+
+    /* Every split point gives the same CRC as one pass */
+    for (size_t cut = 0; cut <= len; cut++) {
+        uint16_t crc = sdi12_crc16_update(0x0000, msg, cut);
+        crc = sdi12_crc16_update(crc, msg + cut, len - cut);
+        TEST_ASSERT_EQUAL_HEX16(whole, crc);
+    }
+}
+
 /* ── ASCII Encoding ─────────────────────────────────────────────────────── */
 
 void test_crc_encode_ascii_zero(void)
@@ -6,7 +6,8 @@
  * test_master.c, and test_metamorphic.c into a single test binary.
  *
  * Build with any C compiler:
- *   gcc -std=c11 -I.. -o test_sdi12 *.c ../sdi12_crc.c ../sdi12_sensor.c ../sdi12_master.c -lm
+ *   gcc -std=c11 -I.. -o test_sdi12 test_*.c ../sdi12_crc.c ../sdi12_decimal.c \
+ *       ../sdi12_binary.c ../sdi12_sensor.c ../sdi12_master.c -lm
  *   ./test_sdi12
  *
  * Or use the provided Makefile:
@@ -27,6 +28,7 @@ extern void test_crc16_empty(void);
 extern void test_crc16_single_char(void);
 extern void test_crc16_known_vector(void);
 extern void test_crc16_different_data_differs(void);
+extern void test_crc16_update_chained(void);
 extern void test_crc_encode_ascii_zero(void);
 extern void test_crc_encode_ascii_all_ones(void);
 extern void test_crc_encode_ascii_printable_range(void);
@@ -47,6 +49,7 @@ extern void test_invalid_special_chars(void);
 extern void test_invalid_control_chars(void);
 extern void test_invalid_boundaries(void);
 extern void test_total_valid_count(void);
+extern void test_address_index_roundtrip(void);
 
 /* test_sensor.c */
 extern void test_sensor_init_ok(void);
@@ -66,6 +69,7 @@ extern void test_sensor_measurement_cc_with_crc(void);
 extern void test_sensor_send_data_after_m(void);
 extern void test_sensor_send_data_with_crc(void);
 extern void test_sensor_send_data_no_data(void);
+extern void test_sensor_send_data_second_page(void);
 extern void test_sensor_continuous_r0(void);
 extern void test_sensor_continuous_rc0_with_crc(void);
 extern void test_sensor_continuous_empty_group(void);
@@ -84,7 +88,23 @@ extern void test_sensor_register_max_params(void);
 extern void test_sensor_group_count(void);
 extern void test_sensor_measurement_done_service_request(void);
 extern void test_sensor_measurement_done_concurrent_no_sr(void);
+extern void test_sensor_measurement_done_decimal(void);
 extern void test_sensor_negative_value_in_data(void);
+extern void test_sensor_sampler_serves_continuous(void);
+extern void test_sensor_sampler_period_refresh(void);
+extern void test_sensor_sampler_max_age_falls_back(void);
+extern void test_sensor_predict_sync_hit(void);
+extern void test_sensor_predict_async_prefetch(void);
+extern void test_sensor_predict_late_adopts(void);
+extern void test_sensor_predict_superseded_prefetch(void);
+extern void test_sensor_shared_sync(void);
+extern void test_sensor_shared_async(void);
+extern void test_sensor_shared_with_prediction(void);
+extern void test_sensor_stats_interval_report(void);
+extern void test_sensor_stats_registration_limits(void);
+extern void test_sensor_history_select_and_download(void);
+extern void test_sensor_history_bulk_pages(void);
+extern void test_sensor_history_selection_bounded(void);
 
 /* test_master.c */
 extern void test_parse_meas_m_basic(void);
@@ -108,6 +128,40 @@ extern void test_parse_values_with_crc_strip(void);
 extern void test_parse_values_large_value(void);
 extern void test_parse_values_mixed_signs(void);
 extern void test_parse_values_null_args(void);
+extern void test_parse_values_correctly_rounded(void);
+extern void test_parse_decimals_exact_roundtrip(void);
+extern void test_framer_complete_and_noise(void);
+extern void test_framer_gap_and_timeout(void);
+extern void test_framer_rejects_garbage(void);
+extern void test_master_recv_framed_early_end(void);
+extern void test_master_recv_char_gap(void);
+extern void test_master_response_len_model(void);
+extern void test_master_meas_reply_len_matches_sensor(void);
+extern void test_master_reply_deadlines(void);
+extern void test_master_retry_recovers(void);
+extern void test_master_retry_learns_and_escalates(void);
+extern void test_master_scan_bus(void);
+extern void test_master_meta_warm_start(void);
+extern void test_master_meta_blob_errors(void);
+extern void test_master_async_measure_service_request(void);
+extern void test_master_async_queue_order_and_pages(void);
+extern void test_master_async_rx_ring(void);
+extern void test_master_break_elision(void);
+extern void test_master_collect_stops_at_count(void);
+extern void test_master_survey_deadline_order(void);
+extern void test_master_survey_estimated_clock(void);
+extern void test_master_sched_admission(void);
+extern void test_master_sched_multi_rate(void);
+extern void test_master_sched_waits_out_ttt(void);
+extern void test_master_get_data_decimal_exact(void);
+extern void test_master_crc_verified_in_parse(void);
+extern void test_master_response_views(void);
+extern void test_master_collect_text_passthrough(void);
+extern void test_master_collect_soa_aggregates(void);
+extern void test_master_hv_binary_streamed(void);
+extern void test_master_collect_hv_pipelined(void);
+extern void test_master_collect_ha_values(void);
+extern void test_bin_decode_all_types(void);
 
 /* test_metamorphic.c — CRC properties */
 extern void test_meta_crc_single_byte_mutation_detected(void);
@@ -147,6 +201,7 @@ int main(void)
     RUN_TEST(test_crc16_single_char);
     RUN_TEST(test_crc16_known_vector);
     RUN_TEST(test_crc16_different_data_differs);
+    RUN_TEST(test_crc16_update_chained);
     RUN_TEST(test_crc_encode_ascii_zero);
     RUN_TEST(test_crc_encode_ascii_all_ones);
     RUN_TEST(test_crc_encode_ascii_printable_range);
@@ -167,6 +222,7 @@ int main(void)
     RUN_TEST(test_invalid_control_chars);
     RUN_TEST(test_invalid_boundaries);
     RUN_TEST(test_total_valid_count);
+    RUN_TEST(test_address_index_roundtrip);
 
     /* ── Sensor (Slave) ─────────────────────────────────────────────────── */
     RUN_TEST(test_sensor_init_ok);
@@ -186,6 +242,7 @@ int main(void)
     RUN_TEST(test_sensor_send_data_after_m);
     RUN_TEST(test_sensor_send_data_with_crc);
     RUN_TEST(test_sensor_send_data_no_data);
+    RUN_TEST(test_sensor_send_data_second_page);
     RUN_TEST(test_sensor_continuous_r0);
     RUN_TEST(test_sensor_continuous_rc0_with_crc);
     RUN_TEST(test_sensor_continuous_empty_group);
@@ -204,7 +261,23 @@ int main(void)
     RUN_TEST(test_sensor_group_count);
     RUN_TEST(test_sensor_measurement_done_service_request);
     RUN_TEST(test_sensor_measurement_done_concurrent_no_sr);
+    RUN_TEST(test_sensor_measurement_done_decimal);
     RUN_TEST(test_sensor_negative_value_in_data);
+    RUN_TEST(test_sensor_sampler_serves_continuous);
+    RUN_TEST(test_sensor_sampler_period_refresh);
+    RUN_TEST(test_sensor_sampler_max_age_falls_back);
+    RUN_TEST(test_sensor_predict_sync_hit);
+    RUN_TEST(test_sensor_predict_async_prefetch);
+    RUN_TEST(test_sensor_predict_late_adopts);
+    RUN_TEST(test_sensor_predict_superseded_prefetch);
+    RUN_TEST(test_sensor_shared_sync);
+    RUN_TEST(test_sensor_shared_async);
+    RUN_TEST(test_sensor_shared_with_prediction);
+    RUN_TEST(test_sensor_stats_interval_report);
+    RUN_TEST(test_sensor_stats_registration_limits);
+    RUN_TEST(test_sensor_history_select_and_download);
+    RUN_TEST(test_sensor_history_bulk_pages);
+    RUN_TEST(test_sensor_history_selection_bounded);
 
     /* ── Master (Data Recorder) ─────────────────────────────────────────── */
     RUN_TEST(test_parse_meas_m_basic);
@@ -228,6 +301,40 @@ int main(void)
     RUN_TEST(test_parse_values_large_value);
     RUN_TEST(test_parse_values_mixed_signs);
     RUN_TEST(test_parse_values_null_args);
+    RUN_TEST(test_parse_values_correctly_rounded);
+    RUN_TEST(test_parse_decimals_exact_roundtrip);
+    RUN_TEST(test_framer_complete_and_noise);
+    RUN_TEST(test_framer_gap_and_timeout);
+    RUN_TEST(test_framer_rejects_garbage);
+    RUN_TEST(test_master_recv_framed_early_end);
+    RUN_TEST(test_master_recv_char_gap);
+    RUN_TEST(test_master_response_len_model);
+    RUN_TEST(test_master_meas_reply_len_matches_sensor);
+    RUN_TEST(test_master_reply_deadlines);
+    RUN_TEST(test_master_retry_recovers);
+    RUN_TEST(test_master_retry_learns_and_escalates);
+    RUN_TEST(test_master_scan_bus);
+    RUN_TEST(test_master_meta_warm_start);
+    RUN_TEST(test_master_meta_blob_errors);
+    RUN_TEST(test_master_async_measure_service_request);
+    RUN_TEST(test_master_async_queue_order_and_pages);
+    RUN_TEST(test_master_async_rx_ring);
+    RUN_TEST(test_master_break_elision);
+    RUN_TEST(test_master_collect_stops_at_count);
+    RUN_TEST(test_master_survey_deadline_order);
+    RUN_TEST(test_master_survey_estimated_clock);
+    RUN_TEST(test_master_sched_admission);
+    RUN_TEST(test_master_sched_multi_rate);
+    RUN_TEST(test_master_sched_waits_out_ttt);
+    RUN_TEST(test_master_get_data_decimal_exact);
+    RUN_TEST(test_master_crc_verified_in_parse);
+    RUN_TEST(test_master_response_views);
+    RUN_TEST(test_master_collect_text_passthrough);
+    RUN_TEST(test_master_collect_soa_aggregates);
+    RUN_TEST(test_master_hv_binary_streamed);
+    RUN_TEST(test_master_collect_hv_pipelined);
+    RUN_TEST(test_master_collect_ha_values);
+    RUN_TEST(test_bin_decode_all_types);
 
     /* ── Metamorphic: CRC Properties ────────────────────────────────────── */
     RUN_TEST(test_meta_crc_single_byte_mutation_detected);
@@ -9,13 +9,36 @@
  *   - parse_data_values for sign-prefixed numeric extraction
  *   - Edge cases: zero values, max values, negative values
  *   - CRC strip behavior
+ *   - Correct rounding of the single-pass value scanner against strtof()
+ *   - Exact decimal values: text round trip, sensor → master end to end
+ *   - CRC verified during value parsing (D, R and decimal paths)
+ *   - Zero-copy response views (aI!, aD0! values, raw pages, aX!)
+ *   - Text pass-through collection (values as sent, no float)
+ *   - Compact structure-of-arrays container across several sensors
+ *   - High-volume binary packets streamed into the caller buffer
+ *   - Pipelined high-volume page collection with per-page retry
+ *   - HA pages parsed in order straight into one value array
+ *   - Binary payload decoding for every type, endian-independent
  *   - Invalid/truncated inputs
+ *   - Receive framer: CR/LF, gap, timeout, garbage rejection
+ *   - Expected-length model and reply deadlines
+ *   - Retry engine and per-address link statistics
+ *   - Bus scan: "?!" short-cuts, collisions, timing against a naive loop
+ *   - Metadata cache: crawl, blob round trip, warm-start revalidation
+ *   - Non-blocking transaction engine against a simulated bus
+ *   - Multi-page collection with early stop
+ *   - Break elision from tracked bus activity
+ *   - Concurrent whole-bus survey
+ *   - Periodic scheduler: cost model, admission control, EDF execution
  */
 #include "sdi12_test.h"
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include "sdi12.h"
 #include "sdi12_master.h"
+#include "sdi12_sensor.h"
 
 /* ── Measurement Response Parsing ───────────────────────────────────────── */
 
@@ -78,6 +101,7 @@ void test_parse_meas_h_three_digit_count(void)
     TEST_ASSERT_EQUAL(SDI12_OK, err);
     TEST_ASSERT_EQUAL(10, resp.wait_seconds);
     TEST_ASSERT_EQUAL(100, resp.value_count);
+    TEST_ASSERT_EQUAL(SDI12_MEAS_HIGHVOL_ASCII, resp.type);
 }
 
 void test_parse_meas_v_same_as_m(void)
@@ -235,3 +259,1839 @@ void test_parse_values_null_args(void)
     TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
         sdi12_master_parse_data_values("+1", 2, vals, 10, NULL, false));
 }
+
+void test_parse_values_correctly_rounded(void)
+{
+    /* Every field width and decimal count, against strtof() */
+    uint32_t seed = 12345u;
+    char text[16];
+    for (int n = 0; n < 200000; n++) {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t digits = (uint8_t)(1 + (seed >> 8) % 7);
+        uint8_t dec = (uint8_t)((seed >> 16) % (digits + 1));
+        uint32_t mod = 1;
+        for (uint8_t i = 0; i < digits; i++) mod *= 10u;
+        seed = seed * 1103515245u + 12345u;
+        uint32_t mant = (seed >> 4) % mod;
+
+        int w = snprintf(text, sizeof(text), "%c%0*lu", (n & 1) ? '-' : '+',
+                         digits, (unsigned long)mant);
+        if (dec) {
+            memmove(text + w - dec + 1, text + w - dec, dec + 1u);
+            text[w - dec] = '.';
+            w++;
+        }
+
+        sdi12_value_t v;
+        uint8_t count = 0;
+        sdi12_master_parse_data_values(text, (size_t)w, &v, 1, &count, false);
+        TEST_ASSERT_EQUAL(1, count);
+        TEST_ASSERT_EQUAL(dec, v.decimals);
+        float ref = strtof(text, NULL);
+        TEST_ASSERT_EQUAL(0, memcmp(&ref, &v.value, sizeof(float)));
+    }
+
+    /* Edge forms: -0, bare point, 8-digit integer, over-long and doubled points */
+    const char *data = "-0.0+.5+99999999+1234.56789-1.2.3";
+    sdi12_value_t vals[5];
+    uint8_t count = 0;
+    sdi12_master_parse_data_values(data, strlen(data), vals, 5, &count, false);
+    TEST_ASSERT_EQUAL(5, count);
+    TEST_ASSERT_TRUE(signbit(vals[0].value));
+    TEST_ASSERT_EQUAL(1, vals[0].decimals);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, vals[1].value);
+    TEST_ASSERT_EQUAL_FLOAT(99999999.0f, vals[2].value);
+    TEST_ASSERT_EQUAL_FLOAT(1234.567f, vals[3].value);   /* 9 chars significant */
+    TEST_ASSERT_EQUAL(3, vals[3].decimals);
+    TEST_ASSERT_EQUAL_FLOAT(-1.2f, vals[4].value);
+}
+
+void test_parse_decimals_exact_roundtrip(void)
+{
+    /* text → decimal → text, every width up to eight digits */
+    uint32_t seed = 777u;
+    char text[16], back[16];
+    for (int n = 0; n < 100000; n++) {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t digits = (uint8_t)(1 + (seed >> 8) % 8);
+        uint8_t dec = digits == 8 ? 0 : (uint8_t)((seed >> 16) % digits);
+        uint32_t mod = 1;
+        for (uint8_t i = 0; i < digits; i++) mod *= 10u;
+        seed = seed * 1103515245u + 12345u;
+        uint32_t mant = (seed >> 2) % mod;
+        if (mant == 0) mant = 1;   /* "-0" would come back as "+0" */
+
+        /* Canonical form: zero-padded only to one digit before the point */
+        int w = snprintf(text, sizeof(text), "%c%0*lu", (n & 1) ? '-' : '+',
+                         dec + 1, (unsigned long)mant);
+        if (dec) {
+            memmove(text + w - dec + 1, text + w - dec, dec + 1u);
+            text[w - dec] = '.';
+            w++;
+        }
+
+        sdi12_decimal_t d;
+        uint8_t count = 0;
+        sdi12_master_parse_data_decimals(text, (size_t)w, &d, 1, &count, false);
+        TEST_ASSERT_EQUAL(1, count);
+        TEST_ASSERT_EQUAL(w, sdi12_decimal_format(back, sizeof(back), d));
+        TEST_ASSERT_EQUAL_STRING(text, back);
+
+        /* Up to seven digits the float convenience form is lossless too */
+        if (digits <= 7) {
+            sdi12_value_t v = { sdi12_decimal_to_float(d), d.decimals };
+            sdi12_decimal_t r = sdi12_decimal_from_value(v);
+            TEST_ASSERT_EQUAL(d.mantissa, r.mantissa);
+            TEST_ASSERT_EQUAL(d.decimals, r.decimals);
+        }
+    }
+
+    /* The eight-digit integer a float cannot hold */
+    sdi12_decimal_t d;
+    uint8_t count = 0;
+    sdi12_master_parse_data_decimals("+99999999", 9, &d, 1, &count, false);
+    TEST_ASSERT_EQUAL(99999999, d.mantissa);
+    TEST_ASSERT_TRUE((int32_t)sdi12_decimal_to_float(d) != 99999999);
+
+    /* Leading zero added, buffer too small refused */
+    sdi12_decimal_t small = { -5, 3 };
+    TEST_ASSERT_EQUAL(6, sdi12_decimal_format(back, sizeof(back), small));
+    TEST_ASSERT_EQUAL_STRING("-0.005", back);
+    TEST_ASSERT_EQUAL(0, sdi12_decimal_format(back, 6, small));
+    TEST_ASSERT_EQUAL(0, sdi12_decimal_scan("1.5", 3, &d));
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_master_parse_data_decimals(NULL, 0, &d, 1, &count, false));
+}
+
+/* ── Simulated Bus ──────────────────────────────────────────────────────── */
+
+/*
+ * Loopback bus on a virtual clock: master commands go straight to
+ * sdi12_sensor_process() on every simulated sensor, and sensor responses
+ * queue up in sim.rx for the master's recv / on_rx. Sensors with ttt > 0
+ * complete their measurement when the clock passes ttt seconds.
+ */
+
+#define SIM_MAX_SENSORS 4
+
+typedef struct {
+    sdi12_sensor_ctx_t ctx;
+    uint16_t ttt;          /**< Seconds returned by start_measurement. */
+    uint32_t done_at;
+    uint8_t  group;
+    bool     busy;
+    uint8_t  id;
+} sim_sensor_t;
+
+static struct {
+    sim_sensor_t s[SIM_MAX_SENSORS];
+    uint8_t  count;
+    char     rx[512];      /**< Sensor → master bytes not yet received. */
+    size_t   rx_len;
+    uint32_t now_ms;
+    uint32_t breaks;
+    uint32_t commands;
+    uint32_t rx_chars;     /**< Characters received so far (exact line time). */
+    uint32_t drop_cmds;    /**< Commands still to be lost on the wire. */
+    uint32_t corrupt_replies; /**< Replies still to get one digit flipped. */
+    uint32_t rx_latency_ms; /**< Adapter delay on every byte after a line's first. */
+    bool     rx_midline;   /**< The latest byte delivered was not a line feed. */
+    uint32_t foreign_sr_ms; /**< Clock at which sensor 9 sends a service request, 0 = never. */
+} sim;
+
+static uint32_t sim_char_ms(size_t chars)
+{
+    return (uint32_t)((chars * 25u + 2u) / 3u);   /* 8.33 ms per char */
+}
+
+static void sim_sensor_send(const char *data, size_t len, void *ud)
+{
+    (void)ud;
+    if (sim.rx_len + len > sizeof(sim.rx)) return;
+    memcpy(sim.rx + sim.rx_len, data, len);
+    sim.rx_len += len;
+}
+
+static void sim_sensor_dir(sdi12_dir_t dir, void *ud) { (void)dir; (void)ud; }
+
+static sdi12_value_t sim_read_param(uint8_t idx, void *ud)
+{
+    const sim_sensor_t *s = (const sim_sensor_t *)ud;
+    sdi12_value_t v = {(float)(s->id * 10 + idx), 1};
+    return v;
+}
+
+static uint16_t sim_start(uint8_t group, sdi12_meas_type_t type, void *ud)
+{
+    (void)type;
+    sim_sensor_t *s = (sim_sensor_t *)ud;
+    if (s->ttt == 0) return 0;
+    s->busy = true;
+    s->group = group;
+    s->done_at = sim.now_ms + (uint32_t)s->ttt * 1000u;
+    return s->ttt;
+}
+
+/** Advance the virtual clock, completing any finished measurements. */
+static void sim_advance(uint32_t ms)
+{
+    sim.now_ms += ms;
+    if (sim.foreign_sr_ms && (int32_t)(sim.now_ms - sim.foreign_sr_ms) >= 0) {
+        sim.foreign_sr_ms = 0;
+        sim_sensor_send("9\r\n", 3, NULL);
+    }
+    for (uint8_t i = 0; i < sim.count; i++) {
+        sim_sensor_t *s = &sim.s[i];
+        if (!s->busy || (int32_t)(sim.now_ms - s->done_at) < 0) continue;
+        s->busy = false;
+
+        sdi12_value_t vals[SDI12_MAX_PARAMS];
+        uint8_t n = sdi12_sensor_group_count(&s->ctx, s->group);
+        for (uint8_t k = 0; k < n; k++) vals[k] = sim_read_param(k, s);
+        sdi12_sensor_measurement_done(&s->ctx, vals, n);
+    }
+}
+
+static void sim_reset(void)
+{
+    memset(&sim, 0, sizeof(sim));
+}
+
+static sim_sensor_t *sim_add_sensor(char addr, uint8_t nparams, uint16_t ttt)
+{
+    sim_sensor_t *s = &sim.s[sim.count];
+    s->id = (uint8_t)(sim.count + 1);
+    s->ttt = ttt;
+    sim.count++;
+
+    sdi12_ident_t ident;
+    memset(&ident, 0, sizeof(ident));
+    memcpy(ident.vendor, "SIMBUS  ", SDI12_ID_VENDOR_LEN);
+    memcpy(ident.model, "SIM001", SDI12_ID_MODEL_LEN);
+    memcpy(ident.firmware_version, "100", SDI12_ID_FWVER_LEN);
+
+    sdi12_sensor_callbacks_t cb;
+    memset(&cb, 0, sizeof(cb));
+    cb.send_response     = sim_sensor_send;
+    cb.set_direction     = sim_sensor_dir;
+    cb.read_param        = sim_read_param;
+    cb.start_measurement = sim_start;
+    cb.user_data         = s;
+    sdi12_sensor_init(&s->ctx, addr, &ident, &cb);
+
+    for (uint8_t i = 0; i < nparams; i++) {
+        sdi12_sensor_register_param(&s->ctx, 0, "P", "u", 1);
+    }
+    return s;
+}
+
+/* Master side of the simulated bus */
+
+static void sim_master_send(const char *data, size_t len, void *ud)
+{
+    (void)ud;
+    sim.commands++;
+    sim_advance(sim_char_ms(len));
+    if (sim.drop_cmds) {
+        sim.drop_cmds--;
+        return;
+    }
+    size_t start = sim.rx_len;
+    uint8_t talkers = 0;
+    for (uint8_t i = 0; i < sim.count; i++) {
+        size_t before = sim.rx_len;
+        sdi12_sensor_process(&sim.s[i].ctx, data, len);
+        if (sim.rx_len != before) talkers++;
+    }
+    if (talkers > 1) sim.rx[start + 1] = 0x15;   /* replies collided */
+    if (sim.corrupt_replies && sim.rx_len > start + 2) {
+        sim.corrupt_replies--;
+        sim.rx[start + 2] ^= 0x01;                 /* "+10.0" → "+00.0" */
+    }
+}
+
+static size_t sim_master_recv(char *buf, size_t buflen, uint32_t timeout_ms, void *ud)
+{
+    (void)ud;
+    for (uint32_t waited = 0; sim.rx_len == 0 && waited < timeout_ms; waited++) {
+        sim_advance(1);
+    }
+    if (sim.rx_len == 0) return 0;
+
+    /* USB-serial latency timer: the rest of a line shows up late */
+    if (sim.rx_latency_ms && sim.rx_midline) {
+        if (timeout_ms < sim.rx_latency_ms) {
+            sim_advance(timeout_ms);
+            return 0;
+        }
+        sim_advance(sim.rx_latency_ms);
+    }
+
+    /* Deliver up to and including the first line feed */
+    size_t n = 0;
+    while (n < sim.rx_len && n < buflen) {
+        if (sim.rx[n++] == '\n') break;
+    }
+    memcpy(buf, sim.rx, n);
+    memmove(sim.rx, sim.rx + n, sim.rx_len - n);
+    sim.rx_len -= n;
+    sim_advance(sim_char_ms(sim.rx_chars + n) - sim_char_ms(sim.rx_chars));
+    sim.rx_chars += (uint32_t)n;
+    sim.rx_midline = buf[n - 1] != '\n';
+    return n;
+}
+
+static void sim_master_dir(sdi12_dir_t dir, void *ud) { (void)dir; (void)ud; }
+
+static void sim_master_break(void *ud)
+{
+    (void)ud;
+    sim.breaks++;
+    sim_advance(SDI12_BREAK_MS);
+    for (uint8_t i = 0; i < sim.count; i++) {
+        sdi12_sensor_break(&sim.s[i].ctx);
+    }
+}
+
+static void sim_master_delay(uint32_t ms, void *ud)
+{
+    (void)ud;
+    sim_advance(ms);
+}
+
+static uint32_t sim_millis(void *ud)
+{
+    (void)ud;
+    return sim.now_ms;
+}
+
+static void sim_master_init(sdi12_master_ctx_t *m)
+{
+    sdi12_master_callbacks_t cb;
+    memset(&cb, 0, sizeof(cb));
+    cb.send          = sim_master_send;
+    cb.recv          = sim_master_recv;
+    cb.set_direction = sim_master_dir;
+    cb.send_break    = sim_master_break;
+    cb.delay         = sim_master_delay;
+    sdi12_master_init(m, &cb);
+}
+
+/** Drive the non-blocking engine in 1 ms steps until idle or `limit_ms`. */
+static void sim_run_async(sdi12_master_ctx_t *m, uint32_t limit_ms)
+{
+    uint32_t end = sim.now_ms + limit_ms;
+    while ((int32_t)(sim.now_ms - end) < 0) {
+        if (sim.rx_len) {
+            sdi12_master_on_rx(m, sim.rx, sim.rx_len, sim.now_ms);
+            sim.rx_len = 0;
+        }
+        if (sdi12_master_poll(m, sim.now_ms) == SDI12_POLL_IDLE) return;
+        sim_advance(1);
+    }
+}
+
+/* ── Receive Framer ─────────────────────────────────────────────────────── */
+
+static sdi12_frame_status_t framer_feed_str(sdi12_framer_t *f, const char *str,
+                                            uint32_t *t_us)
+{
+    sdi12_frame_status_t st = f->status;
+    for (; *str; str++) {
+        *t_us += SDI12_CHAR_US;
+        st = sdi12_framer_feed(f, *str, *t_us);
+    }
+    return st;
+}
+
+void test_framer_complete_and_noise(void)
+{
+    char buf[32];
+    sdi12_framer_t f;
+    uint32_t t = 1000;
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+
+    /* Turnaround glitch before the frame is dropped */
+    TEST_ASSERT_EQUAL(SDI12_FRAME_PENDING, sdi12_framer_feed(&f, '\0', t));
+    TEST_ASSERT_EQUAL(SDI12_FRAME_PENDING, framer_feed_str(&f, "0+1.5\r", &t));
+    TEST_ASSERT_EQUAL(SDI12_FRAME_COMPLETE, framer_feed_str(&f, "\n", &t));
+    TEST_ASSERT_EQUAL_STRING("0+1.5\r\n", buf);
+    TEST_ASSERT_EQUAL(7, f.len);
+
+    /* Sticky once complete */
+    TEST_ASSERT_EQUAL(SDI12_FRAME_COMPLETE, sdi12_framer_feed(&f, 'x', t));
+    TEST_ASSERT_EQUAL(7, f.len);
+
+    /* Known length completes without waiting */
+    sdi12_framer_start(&f, buf, sizeof(buf), '\0', 3, t);
+    TEST_ASSERT_EQUAL(SDI12_FRAME_COMPLETE, framer_feed_str(&f, "0\r\n", &t));
+
+    /* DEL is a valid CRC character, not noise */
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+    TEST_ASSERT_EQUAL(SDI12_FRAME_COMPLETE, framer_feed_str(&f, "0+1A\x7F" "A\r\n", &t));
+}
+
+void test_framer_gap_and_timeout(void)
+{
+    char buf[32];
+    sdi12_framer_t f;
+    uint32_t t = 0xFFFFF000u;            /* timestamps wrap */
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+
+    /* First byte: response timeout plus one character */
+    uint32_t limit = SDI12_RESPONSE_TIMEOUT_MS * 1000u + SDI12_CHAR_US;
+    TEST_ASSERT_EQUAL(SDI12_FRAME_PENDING, sdi12_framer_poll(&f, t + limit));
+    TEST_ASSERT_EQUAL(SDI12_FRAME_TIMEOUT, sdi12_framer_poll(&f, t + limit + 1));
+
+    /* Sensor stops mid-frame: truncated after char time + 1.66 ms */
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+    framer_feed_str(&f, "0+1", &t);
+    uint32_t gap = SDI12_CHAR_US + SDI12_INTERCHAR_MAX_US;
+    TEST_ASSERT_EQUAL(SDI12_FRAME_PENDING, sdi12_framer_poll(&f, t + gap));
+    TEST_ASSERT_EQUAL(SDI12_FRAME_TRUNCATED, sdi12_framer_poll(&f, t + gap + 1));
+
+    /* A late byte is not glued onto the old frame */
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+    framer_feed_str(&f, "0+1", &t);
+    TEST_ASSERT_EQUAL(SDI12_FRAME_TRUNCATED, sdi12_framer_feed(&f, '2', t + gap + 1));
+    TEST_ASSERT_EQUAL_STRING("0+1", buf);
+}
+
+void test_framer_rejects_garbage(void)
+{
+    char buf[8];
+    sdi12_framer_t f;
+    uint32_t t = 0;
+
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+    TEST_ASSERT_EQUAL(SDI12_FRAME_GARBAGE, framer_feed_str(&f, "1", &t));
+
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+    TEST_ASSERT_EQUAL(SDI12_FRAME_GARBAGE, framer_feed_str(&f, "0+\x01", &t));
+
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+    TEST_ASSERT_EQUAL(SDI12_FRAME_GARBAGE, framer_feed_str(&f, "0\rX", &t));
+
+    /* Longer than the buffer or the known length */
+    sdi12_framer_start(&f, buf, sizeof(buf), '\0', 0, t);
+    TEST_ASSERT_EQUAL(SDI12_FRAME_GARBAGE, framer_feed_str(&f, "0+1+2+3+4", &t));
+    sdi12_framer_start(&f, buf, sizeof(buf), '\0', 3, t);
+    TEST_ASSERT_EQUAL(SDI12_FRAME_COMPLETE, framer_feed_str(&f, "0+1", &t));
+
+    sdi12_framer_start(&f, buf, 1, '\0', 0, t);
+    TEST_ASSERT_EQUAL(SDI12_FRAME_GARBAGE, f.status);
+}
+
+/* ── Non-blocking Engine ────────────────────────────────────────────────── */
+
+static char txn_log[8];
+static size_t txn_log_len;
+
+static void txn_record(sdi12_txn_t *txn, void *ud)
+{
+    (void)ud;
+    if (txn_log_len < sizeof(txn_log) - 1) txn_log[txn_log_len++] = txn->addr;
+}
+
+void test_master_async_measure_service_request(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 3, 2);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    sdi12_txn_t txn;
+    memset(&txn, 0, sizeof(txn));
+    txn.kind = SDI12_TXN_MEASURE;
+    txn.addr = '0';
+    txn.type = SDI12_MEAS_STANDARD;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_submit(&m, &txn));
+    TEST_ASSERT_EQUAL(SDI12_MARKING_MS, sdi12_master_poll(&m, sim.now_ms));
+
+    sim_run_async(&m, 10000);
+    TEST_ASSERT_EQUAL(SDI12_OK, txn.result);
+    TEST_ASSERT_EQUAL(2, txn.meas.wait_seconds);
+    TEST_ASSERT_EQUAL(3, txn.data.value_count);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.0f, txn.data.values[2].value);
+
+    /* Service request ended the wait after ttt, not at a timeout */
+    TEST_ASSERT_TRUE(sim.now_ms < 2300);
+    TEST_ASSERT_EQUAL(SDI12_POLL_IDLE, sdi12_master_poll(&m, sim.now_ms));
+}
+
+void test_master_async_queue_order_and_pages(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 1, 0);
+    sim_add_sensor('1', 20, 1);      /* 20 values → two D pages after aC! */
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    txn_log_len = 0;
+
+    sdi12_txn_t t[3];
+    memset(t, 0, sizeof(t));
+    t[0].kind = SDI12_TXN_COMMAND;
+    strcpy(t[0].cmd, "0I!");
+    t[1].kind = SDI12_TXN_MEASURE;
+    t[1].addr = '1';
+    t[1].type = SDI12_MEAS_CONCURRENT;
+    t[1].crc = true;
+    t[2].kind = SDI12_TXN_MEASURE;
+    t[2].addr = '5';                 /* nobody there */
+    t[2].type = SDI12_MEAS_STANDARD;
+    for (int i = 0; i < 3; i++) {
+        t[i].on_done = txn_record;
+        TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_submit(&m, &t[i]));
+    }
+
+    sim_run_async(&m, 10000);
+    TEST_ASSERT_EQUAL(3, txn_log_len);
+    TEST_ASSERT_EQUAL(0, memcmp(txn_log, "015", 3));
+
+    TEST_ASSERT_EQUAL(SDI12_OK, t[0].result);
+    TEST_ASSERT_EQUAL(0, strncmp(t[0].resp, "014SIMBUS", 9));
+
+    TEST_ASSERT_EQUAL(SDI12_OK, t[1].result);
+    TEST_ASSERT_TRUE(t[1].data.crc_valid);
+    TEST_ASSERT_EQUAL(20, t[1].data.value_count);
+    TEST_ASSERT_EQUAL(1, t[1].page);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 39.0f, t[1].data.values[19].value);
+
+    TEST_ASSERT_EQUAL(SDI12_ERR_TIMEOUT, t[2].result);
+
+    /* Bad requests are rejected at submit */
+    sdi12_txn_t bad;
+    memset(&bad, 0, sizeof(bad));
+    bad.kind = SDI12_TXN_MEASURE;
+    bad.addr = '#';
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_ADDRESS, sdi12_master_submit(&m, &bad));
+    bad.kind = SDI12_TXN_COMMAND;
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND, sdi12_master_submit(&m, &bad));
+}
+
+void test_master_async_rx_ring(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 1, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    sdi12_txn_t txn;
+    memset(&txn, 0, sizeof(txn));
+    txn.kind = SDI12_TXN_COMMAND;
+    strcpy(txn.cmd, "0!");
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_submit(&m, &txn));
+    sdi12_master_poll(&m, sim.now_ms);           /* break */
+    sim_advance(SDI12_MARKING_MS);
+    sdi12_master_poll(&m, sim.now_ms);           /* 0! */
+    TEST_ASSERT_EQUAL(3, sim.rx_len);
+
+    /* on_rx only queues; the late poll parses, with the arrival time
+     * kept as the last bus activity */
+    uint32_t arrived = sim.now_ms + 8;
+    sdi12_master_on_rx(&m, sim.rx, sim.rx_len, arrived);
+    sim.rx_len = 0;
+    TEST_ASSERT_EQUAL(0, txn.resp_len);
+    TEST_ASSERT_EQUAL(SDI12_POLL_IDLE, sdi12_master_poll(&m, arrived + 40));
+    TEST_ASSERT_EQUAL(SDI12_OK, txn.result);
+    TEST_ASSERT_EQUAL_STRING("0", txn.resp);
+    TEST_ASSERT_EQUAL(arrived, m.last_bus_ms);
+
+    /* More than the ring holds before a poll: the reply is failed */
+    memset(&txn, 0, sizeof(txn));
+    txn.kind = SDI12_TXN_MEASURE;
+    txn.addr = '0';
+    txn.type = SDI12_MEAS_STANDARD;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_submit(&m, &txn));
+    sdi12_master_poll(&m, arrived + 41);
+    TEST_ASSERT_EQUAL(2, sim.commands);          /* 0M! out, no second break */
+    TEST_ASSERT_EQUAL(1, sim.breaks);
+    sim.rx_len = 0;
+    char noise[SDI12_RX_RING_SIZE + 30];
+    for (size_t i = 0; i + 3 <= sizeof(noise); i += 3) memcpy(noise + i, "1\r\n", 3);
+    sdi12_master_on_rx(&m, noise, sizeof(noise), arrived + 42);
+    sdi12_master_poll(&m, arrived + 43);
+    TEST_ASSERT_EQUAL(SDI12_ERR_BUFFER_OVERFLOW, txn.result);
+}
+
+void test_master_recv_framed_early_end(void)
+{
+    sim_reset();
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    /* Noise mid-frame: rejected, rest of the frame drained */
+    memcpy(sim.rx, "5+1\x01+2.0\r\n", 10);
+    sim.rx_len = 10;
+    TEST_ASSERT_EQUAL(SDI12_ERR_PARSE_FAILED, sdi12_master_transact(&m, "5D0!", 1000));
+    TEST_ASSERT_EQUAL(0, sim.rx_len);
+
+    /* Sensor stops without CR/LF: ends one gap later, not at the timeout */
+    sdi12_master_set_char_gap(&m, SDI12_CHAR_GAP_MS);
+    memcpy(sim.rx, "5+1.2", 5);
+    sim.rx_len = 5;
+    uint32_t t0 = sim.now_ms;
+    TEST_ASSERT_EQUAL(SDI12_ERR_PARSE_FAILED, sdi12_master_transact(&m, "5D0!", 1000));
+    TEST_ASSERT_TRUE(sim.now_ms - t0 < 100);
+
+    /* Normal reply */
+    memcpy(sim.rx, "5\r\n", 3);
+    sim.rx_len = 3;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_transact(&m, "5!", 1000));
+    TEST_ASSERT_EQUAL(3, m.resp_len);
+}
+
+void test_master_recv_char_gap(void)
+{
+    sim_reset();
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    TEST_ASSERT_EQUAL(0, m.char_gap_ms);
+
+    /* Line mode by default: a 16 ms USB-serial adapter works unchanged */
+    sim.rx_latency_ms = 16;
+    memcpy(sim.rx, "5+1.2\r\n", 7);
+    sim.rx_len = 7;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_transact(&m, "5D0!", 1000));
+    TEST_ASSERT_EQUAL(7, m.resp_len);
+
+    /* ... and a reply that stops short still ends before the timeout */
+    memcpy(sim.rx, "5+1.2", 5);
+    sim.rx_len = 5;
+    uint32_t t0 = sim.now_ms;
+    TEST_ASSERT_EQUAL(SDI12_ERR_PARSE_FAILED, sdi12_master_transact(&m, "5D0!", 5000));
+    TEST_ASSERT_TRUE(sim.now_ms - t0 < 5000);
+
+    /* The per-byte gap is too short for that adapter... */
+    sim.rx_midline = false;
+    sdi12_master_set_char_gap(&m, SDI12_CHAR_GAP_MS);
+    memcpy(sim.rx, "5+1.2\r\n", 7);
+    sim.rx_len = 7;
+    TEST_ASSERT_EQUAL(SDI12_ERR_PARSE_FAILED, sdi12_master_transact(&m, "5D0!", 1000));
+
+    /* ... unless its latency is added */
+    sim.rx_len = 0;
+    sim.rx_midline = false;
+    sdi12_master_set_char_gap(&m, SDI12_CHAR_GAP_MS + 16);
+    memcpy(sim.rx, "5+1.2\r\n", 7);
+    sim.rx_len = 7;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_transact(&m, "5D0!", 1000));
+
+    /* A worst-case legal gap seen through a 1 ms tick (11 ms) fits it */
+    sim.rx_latency_ms = 11;
+    sdi12_master_set_char_gap(&m, SDI12_CHAR_GAP_MS);
+    memcpy(sim.rx, "5+1.2\r\n", 7);
+    sim.rx_len = 7;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_transact(&m, "5D0!", 1000));
+    TEST_ASSERT_EQUAL(7, m.resp_len);
+}
+
+/* ── Response Length Model ──────────────────────────────────────────────── */
+
+void test_master_response_len_model(void)
+{
+    sdi12_resp_len_t r = sdi12_master_response_len("0!");
+    TEST_ASSERT_EQUAL(3, r.min);
+    TEST_ASSERT_EQUAL(3, r.max);
+    r = sdi12_master_response_len("0MC2!");
+    TEST_ASSERT_EQUAL(7, r.min);
+    TEST_ASSERT_EQUAL(7, r.max);
+    TEST_ASSERT_EQUAL(8, sdi12_master_response_len("0CC!").max);
+    TEST_ASSERT_EQUAL(9, sdi12_master_response_len("0HB!").max);
+    TEST_ASSERT_EQUAL(9, sdi12_master_response_len("0IHA!").max);
+    r = sdi12_master_response_len("0I!");
+    TEST_ASSERT_EQUAL(22, r.min);
+    TEST_ASSERT_EQUAL(35, r.max);
+    TEST_ASSERT_EQUAL(81, sdi12_master_response_len("0D0!").max);
+    TEST_ASSERT_EQUAL(SDI12_RESP_MAX_CHARS, sdi12_master_response_len("0XRUN!").max);
+
+    /* "0M!": 3 chars out, 15 ms turnaround, 7 chars back */
+    TEST_ASSERT_EQUAL(25 + 15 + 59, sdi12_master_response_deadline_ms("0M!"));
+
+    /* The framer enforces the bounds */
+    char buf[32];
+    sdi12_framer_t f;
+    uint32_t t = 0;
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+    sdi12_framer_expect(&f, sdi12_master_response_len("0M!"));
+    TEST_ASSERT_EQUAL(SDI12_FRAME_TRUNCATED, framer_feed_str(&f, "000\r\n", &t));
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+    sdi12_framer_expect(&f, sdi12_master_response_len("0M!"));
+    TEST_ASSERT_EQUAL(SDI12_FRAME_GARBAGE, framer_feed_str(&f, "000123\r\n", &t));
+    TEST_ASSERT_EQUAL(7, f.len);
+    sdi12_framer_start(&f, buf, sizeof(buf), '0', 0, t);
+    sdi12_framer_expect(&f, sdi12_master_response_len("0M!"));
+    TEST_ASSERT_EQUAL(SDI12_FRAME_COMPLETE, framer_feed_str(&f, "00013\r\n", &t));
+}
+
+void test_master_meas_reply_len_matches_sensor(void)
+{
+    static const sdi12_meas_type_t types[] = {
+        SDI12_MEAS_STANDARD, SDI12_MEAS_CONCURRENT, SDI12_MEAS_VERIFICATION,
+        SDI12_MEAS_HIGHVOL_ASCII, SDI12_MEAS_HIGHVOL_BINARY
+    };
+
+    /* Every measurement reply the sensor sends fits the master's model,
+       an empty group's "nothing to measure" reply included */
+    for (uint8_t nparams = 0; nparams <= 3; nparams += 3) {
+        sim_reset();
+        sim_add_sensor('0', nparams, 0);
+        sdi12_master_ctx_t m;
+        sim_master_init(&m);
+
+        for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+            for (int crc = 0; crc <= 1; crc++) {
+                sdi12_meas_response_t resp;
+                TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_start_measurement(
+                    &m, '0', types[i], 0, crc != 0, &resp));
+                TEST_ASSERT_EQUAL(nparams, resp.value_count);
+                TEST_ASSERT_EQUAL(0, resp.wait_seconds);
+                TEST_ASSERT_EQUAL(0, sim.rx_len);
+            }
+        }
+    }
+}
+
+void test_master_reply_deadlines(void)
+{
+    sim_reset();
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    /* Over-long ack is rejected and drained */
+    memcpy(sim.rx, "5000123\r\n", 9);
+    sim.rx_len = 9;
+    TEST_ASSERT_EQUAL(SDI12_ERR_PARSE_FAILED, sdi12_master_transact(&m, "5M!", 1000));
+    TEST_ASSERT_EQUAL(0, sim.rx_len);
+
+    /* Async: an absent sensor times out at the first-byte deadline */
+    sdi12_txn_t txn;
+    memset(&txn, 0, sizeof(txn));
+    txn.kind = SDI12_TXN_COMMAND;
+    strcpy(txn.cmd, "5M!");
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_submit(&m, &txn));
+    uint32_t t0 = sim.now_ms;
+    sim_run_async(&m, 1000);
+    TEST_ASSERT_EQUAL(SDI12_ERR_TIMEOUT, txn.result);
+    TEST_ASSERT_TRUE(sim.now_ms - t0 <= SDI12_BREAK_MS + SDI12_MARKING_MS + 25 + 15 + 9 + 1);
+
+    /* A present sensor gets the full reply time once it starts talking */
+    sim_add_sensor('0', 2, 0);
+    memset(&txn, 0, sizeof(txn));
+    txn.kind = SDI12_TXN_MEASURE;
+    txn.addr = '0';
+    txn.type = SDI12_MEAS_STANDARD;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_submit(&m, &txn));
+    sim_run_async(&m, 1000);
+    TEST_ASSERT_EQUAL(SDI12_OK, txn.result);
+    TEST_ASSERT_EQUAL(2, txn.data.value_count);
+}
+
+/* ── Retry Engine ───────────────────────────────────────────────────────── */
+
+void test_master_retry_recovers(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 1, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    m.cb.millis = sim_millis;
+    bool present = false;
+
+    /* Without a link table a lost command is simply lost */
+    sdi12_master_send_break(&m);
+    sim.drop_cmds = 1;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_acknowledge(&m, '0', &present));
+    TEST_ASSERT_FALSE(present);
+
+    sdi12_link_t links[4];
+    sdi12_master_set_links(&m, links, 4);
+    sim.drop_cmds = 2;
+    uint32_t cmds = sim.commands;
+    uint32_t breaks = sim.breaks;
+    uint32_t t0 = sim.now_ms;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_acknowledge(&m, '0', &present));
+    TEST_ASSERT_TRUE(present);
+    TEST_ASSERT_EQUAL(3, sim.commands - cmds);
+    TEST_ASSERT_EQUAL(breaks, sim.breaks);
+    TEST_ASSERT_TRUE(sim.now_ms - t0 >= 2 * SDI12_RETRY_MIN_MS);
+
+    const sdi12_link_t *l = sdi12_master_link(&m, '0');
+    TEST_ASSERT_NOT_NULL(l);
+    TEST_ASSERT_EQUAL(1, l->transactions);
+    TEST_ASSERT_EQUAL(2, l->retries);
+    TEST_ASSERT_EQUAL(2, l->timeouts);
+    TEST_ASSERT_EQUAL(1, l->ok);
+    TEST_ASSERT_EQUAL(0, l->failures);
+    TEST_ASSERT_NULL(sdi12_master_link(&m, '1'));
+}
+
+void test_master_retry_learns_and_escalates(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 1, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    m.cb.millis = sim_millis;
+    sdi12_link_t links[2];
+    sdi12_master_set_links(&m, links, 2);
+    bool present = false;
+
+    /* Healthy sensor: turnaround learned, timeout tightened */
+    sdi12_master_send_break(&m);
+    for (int i = 0; i < SDI12_LINK_LEARN; i++) {
+        TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_acknowledge(&m, '0', &present));
+    }
+    const sdi12_link_t *l0 = sdi12_master_link(&m, '0');
+    TEST_ASSERT_TRUE(l0->latency_max_ms <= 1);
+    sim.drop_cmds = 1;
+    uint32_t t0 = sim.now_ms;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_transact(&m, "0!", 500));
+    TEST_ASSERT_TRUE(sim.now_ms - t0 < 100);
+
+    /* Absent sensor: three retries, then a failure */
+    uint32_t cmds = sim.commands;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_acknowledge(&m, '5', &present));
+    TEST_ASSERT_FALSE(present);
+    const sdi12_link_t *l5 = sdi12_master_link(&m, '5');
+    TEST_ASSERT_EQUAL(1 + SDI12_LINK_RETRIES, sim.commands - cmds);
+    TEST_ASSERT_EQUAL(SDI12_LINK_RETRIES, l5->retries);
+    TEST_ASSERT_EQUAL(1, l5->failures);
+    TEST_ASSERT_TRUE(l5->fail_permille >= SDI12_LINK_FLAKY_PERMILLE);
+
+    /* Now flaky: a second round after a fresh break */
+    cmds = sim.commands;
+    uint32_t breaks = sim.breaks;
+    sdi12_master_acknowledge(&m, '5', &present);
+    TEST_ASSERT_EQUAL(2 * (1 + SDI12_LINK_RETRIES), sim.commands - cmds);
+    TEST_ASSERT_TRUE(sim.breaks > breaks);
+
+    /* Table full: the third address runs once, without statistics */
+    cmds = sim.commands;
+    sdi12_master_acknowledge(&m, '7', &present);
+    TEST_ASSERT_EQUAL(1, sim.commands - cmds);
+    TEST_ASSERT_NULL(sdi12_master_link(&m, '7'));
+
+    /* No clock: long waits add up to the marking timeout — re-break */
+    sdi12_master_ctx_t m2;
+    sim_master_init(&m2);
+    sdi12_link_t link;
+    sdi12_master_set_links(&m2, &link, 1);
+    sdi12_master_send_break(&m2);
+    TEST_ASSERT_EQUAL(SDI12_ERR_TIMEOUT, sdi12_master_transact(&m2, "3!", 100));
+    TEST_ASSERT_EQUAL(SDI12_LINK_RETRIES, link.rebreaks);
+}
+
+/* ── Bus Scan ───────────────────────────────────────────────────────────── */
+
+/** Simulated time for a scan, from a cold bus. */
+static uint32_t scan_time(bool exhaustive, uint64_t *found)
+{
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    m.cb.millis = sim_millis;
+    uint32_t t0 = sim.now_ms;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_scan(&m, exhaustive, found));
+    return sim.now_ms - t0;
+}
+
+void test_master_scan_bus(void)
+{
+    uint64_t found;
+
+    /* Empty bus: one "?!" timeout */
+    sim_reset();
+    TEST_ASSERT_TRUE(scan_time(true, &found) < 60);
+    TEST_ASSERT_TRUE(found == 0);
+
+    /* Single sensor: "?!" plus a confirming "a!" */
+    sim_add_sensor('7', 1, 0);
+    TEST_ASSERT_TRUE(scan_time(false, &found) < 120);
+    TEST_ASSERT_TRUE(found == (uint64_t)1 << 7);
+
+    /* Three sensors: "?!" collides, every address probed */
+    sim_add_sensor('B', 1, 0);
+    sim_add_sensor('z', 1, 0);
+    uint32_t breaks = sim.breaks;
+    uint32_t scan_ms = scan_time(false, &found);
+    TEST_ASSERT_TRUE(found == (((uint64_t)1 << 7) | ((uint64_t)1 << 11) |
+                               ((uint64_t)1 << 61)));
+    TEST_ASSERT_EQUAL(1, sim.breaks - breaks);   /* one break per scan */
+
+    /* Benchmark: a break + acknowledge loop over all 62 addresses */
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    uint32_t t0 = sim.now_ms;
+    for (int i = 0; i < 62; i++) {
+        bool present;
+        sdi12_master_send_break(&m);
+        sdi12_master_acknowledge(&m, sdi12_address_from_index(i), &present);
+    }
+    uint32_t loop_ms = sim.now_ms - t0;
+    TEST_ASSERT_TRUE(scan_ms < 62 * 35);          /* ~2.1 s: 62 × (17 + 15) ms */
+    TEST_ASSERT_TRUE(scan_ms * 3 < loop_ms * 2);  /* loop: ~3.3 s */
+}
+
+/* ── Metadata Cache ─────────────────────────────────────────────────────── */
+
+void test_master_meta_warm_start(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 3, 0);
+    sim_add_sensor('1', 12, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    sdi12_master_send_break(&m);
+
+    sdi12_meta_entry_t slots[3];
+    sdi12_meta_cache_t cache;
+    sdi12_meta_init(&cache, slots, 3);
+
+    /* Cold: both sensors crawled */
+    const sdi12_meta_entry_t *e = NULL;
+    bool crawled = false;
+    uint32_t cmds = sim.commands;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_meta_refresh(&m, &cache, '0', &e, &crawled));
+    TEST_ASSERT_TRUE(crawled);
+    TEST_ASSERT_EQUAL(0, strncmp(e->ident, "14SIMBUS  SIM001100", 19));
+    TEST_ASSERT_EQUAL(3, e->m_count[0]);
+    TEST_ASSERT_EQUAL(3, e->c_count[0]);
+    TEST_ASSERT_EQUAL(3, e->param_count);
+    TEST_ASSERT_EQUAL_STRING("P", sdi12_meta_param(e, 0, 3)->shef);
+    TEST_ASSERT_EQUAL_STRING("u", sdi12_meta_param(e, 0, 3)->units);
+    TEST_ASSERT_NULL(sdi12_meta_param(e, 0, 4));
+    TEST_ASSERT_TRUE(sim.commands - cmds > 6);
+
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_meta_refresh(&m, &cache, '1', &e, &crawled));
+    TEST_ASSERT_EQUAL(9, e->m_count[0]);       /* aIM! caps at 9 */
+    TEST_ASSERT_EQUAL(12, e->c_count[0]);
+    TEST_ASSERT_EQUAL(12, e->param_count);     /* listed via aIC_nnn! */
+
+    /* Round trip through the blob */
+    uint8_t blob[256];
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_meta_serialize(&cache, blob, sizeof(blob), &len));
+    TEST_ASSERT_TRUE(len < 128);                /* vs ~1.6 kB of entries */
+    sdi12_meta_entry_t slots2[3];
+    sdi12_meta_cache_t warm;
+    sdi12_meta_init(&warm, slots2, 3);
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_meta_deserialize(&warm, blob, len));
+    TEST_ASSERT_EQUAL(0, memcmp(slots, slots2, sizeof(slots)));
+
+    /* Warm: one aI! per unchanged sensor */
+    cmds = sim.commands;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_meta_refresh(&m, &warm, '0', &e, &crawled));
+    TEST_ASSERT_FALSE(crawled);
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_meta_refresh(&m, &warm, '1', &e, &crawled));
+    TEST_ASSERT_FALSE(crawled);
+    TEST_ASSERT_EQUAL(2, sim.commands - cmds);
+
+    /* Firmware change: re-crawled in place */
+    memcpy(sim.s[1].ctx.ident.firmware_version, "101", 3);
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_meta_refresh(&m, &warm, '1', &e, &crawled));
+    TEST_ASSERT_TRUE(crawled);
+    TEST_ASSERT_TRUE(e == sdi12_meta_find(&warm, '1'));
+    TEST_ASSERT_EQUAL(0, strncmp(e->ident + 16, "101", 3));
+}
+
+void test_master_meta_blob_errors(void)
+{
+    sdi12_meta_entry_t slots[2];
+    sdi12_meta_cache_t cache;
+    sdi12_meta_init(&cache, slots, 2);
+    slots[0].addr = '4';
+    strcpy(slots[0].ident, "14VENDOR  MODEL1001");
+    slots[0].m_count[0] = 1;
+    slots[0].param_count = 1;
+    strcpy(slots[0].params[0].shef, "TA");
+    strcpy(slots[0].params[0].units, "C");
+
+    uint8_t blob[64];
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(SDI12_ERR_BUFFER_OVERFLOW, sdi12_meta_serialize(&cache, blob, 20, &len));
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_meta_serialize(&cache, blob, sizeof(blob), &len));
+
+    blob[8] ^= 0x01;
+    TEST_ASSERT_EQUAL(SDI12_ERR_CRC_MISMATCH, sdi12_meta_deserialize(&cache, blob, len));
+    TEST_ASSERT_NULL(sdi12_meta_find(&cache, '4'));
+    blob[8] ^= 0x01;
+
+    TEST_ASSERT_EQUAL(SDI12_ERR_PARSE_FAILED, sdi12_meta_deserialize(&cache, blob, 3));
+    sdi12_meta_cache_t tiny = { slots, 0 };
+    TEST_ASSERT_EQUAL(SDI12_ERR_BUFFER_OVERFLOW, sdi12_meta_deserialize(&tiny, blob, len));
+
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_meta_deserialize(&cache, blob, len));
+    TEST_ASSERT_EQUAL_STRING("TA", sdi12_meta_param(sdi12_meta_find(&cache, '4'), 0, 1)->shef);
+}
+
+/* ── Break Elision ──────────────────────────────────────────────────────── */
+
+void test_master_break_elision(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 1, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    m.cb.millis = sim_millis;
+
+    /* Break before every command, as typical code does */
+    for (int i = 0; i < 5; i++) {
+        sdi12_master_send_break(&m);
+        TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_transact(&m, "0!", SDI12_RESPONSE_TIMEOUT_MS));
+    }
+    TEST_ASSERT_EQUAL(1, sim.breaks);
+    TEST_ASSERT_EQUAL(4, m.breaks_elided);
+
+    /* Still inside the 87 ms marking window */
+    sim_advance(SDI12_MARKING_TIMEOUT_MS - 10);
+    sdi12_master_send_break(&m);
+    TEST_ASSERT_EQUAL(1, sim.breaks);
+
+    /* Marking timeout passed: sensors may be asleep */
+    sim_advance(20);
+    sdi12_master_send_break(&m);
+    TEST_ASSERT_EQUAL(2, sim.breaks);
+
+    /* Forced break always goes out */
+    sdi12_master_force_break(&m);
+    TEST_ASSERT_EQUAL(3, sim.breaks);
+
+    /* No clock: idle time unknown, always break */
+    sdi12_master_ctx_t plain;
+    sim_master_init(&plain);
+    sdi12_master_send_break(&plain);
+    sdi12_master_send_break(&plain);
+    TEST_ASSERT_EQUAL(5, sim.breaks);
+    TEST_ASSERT_EQUAL(0, plain.breaks_elided);
+}
+
+/* ── Collect ────────────────────────────────────────────────────────────── */
+
+void test_master_collect_stops_at_count(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 9, 0);        /* 9 × "+1x.0" → pages of 7 + 2 */
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    sdi12_master_send_break(&m);
+    sdi12_meas_response_t mr;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_start_measurement(
+        &m, '0', SDI12_MEAS_STANDARD, 0, false, &mr));
+    TEST_ASSERT_EQUAL(9, mr.value_count);
+
+    sdi12_data_response_t d;
+    sim.commands = 0;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_collect(&m, '0', &mr, false, &d));
+    TEST_ASSERT_EQUAL(9, d.value_count);
+    TEST_ASSERT_EQUAL(2, sim.commands);          /* D0, D1 — no empty D2 */
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 18.0f, d.values[8].value);
+
+    /* Sensor announces more than it delivers: stop at the empty page */
+    mr.value_count = 10;
+    sim.commands = 0;
+    TEST_ASSERT_EQUAL(SDI12_ERR_NO_DATA, sdi12_master_collect(&m, '0', &mr, false, &d));
+    TEST_ASSERT_EQUAL(9, d.value_count);
+    TEST_ASSERT_EQUAL(3, sim.commands);
+
+    /* Nothing announced: nothing sent */
+    mr.value_count = 0;
+    sim.commands = 0;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_collect(&m, '0', &mr, false, &d));
+    TEST_ASSERT_EQUAL(0, sim.commands);
+
+    mr.value_count = SDI12_MAX_VALUES + 1;
+    TEST_ASSERT_EQUAL(SDI12_ERR_BUFFER_OVERFLOW, sdi12_master_collect(&m, '0', &mr, false, &d));
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_ADDRESS, sdi12_master_collect(&m, '?', &mr, false, &d));
+}
+
+/* ── Survey ─────────────────────────────────────────────────────────────── */
+
+void test_master_survey_deadline_order(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 3, 3);
+    sim_add_sensor('1', 20, 1);
+    sim_add_sensor('2', 2, 2);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    m.cb.millis = sim_millis;
+
+    sdi12_survey_entry_t e[4];
+    memset(e, 0, sizeof(e));
+    e[0].addr = '0';
+    e[1].addr = '1';
+    e[1].crc = true;
+    e[2].addr = '2';
+    e[3].addr = '7';                  /* absent */
+
+    sdi12_survey_stats_t st;
+    uint32_t t0 = sim.now_ms;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_survey(&m, e, 4, &st));
+
+    TEST_ASSERT_EQUAL(SDI12_OK, e[0].result);
+    TEST_ASSERT_EQUAL(3, e[0].data.value_count);
+    TEST_ASSERT_EQUAL(SDI12_OK, e[1].result);
+    TEST_ASSERT_EQUAL(20, e[1].data.value_count);
+    TEST_ASSERT_TRUE(e[1].data.crc_valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 39.0f, e[1].data.values[19].value);
+    TEST_ASSERT_EQUAL(SDI12_OK, e[2].result);
+    TEST_ASSERT_EQUAL(SDI12_ERR_TIMEOUT, e[3].result);
+    TEST_ASSERT_EQUAL(3, st.ok);
+
+    /* Collected in ready order: ttt 1 s, 2 s, 3 s */
+    TEST_ASSERT_TRUE(e[1].done_ms < e[2].done_ms);
+    TEST_ASSERT_TRUE(e[2].done_ms < e[0].done_ms);
+    TEST_ASSERT_TRUE(e[1].done_ms >= e[1].ready_ms);
+
+    /* Overlapped: the longest ttt plus bus time, not the sum of all */
+    TEST_ASSERT_EQUAL(sim.now_ms - t0, st.wall_ms);
+    TEST_ASSERT_TRUE(st.wall_ms < 3500);
+    TEST_ASSERT_TRUE(st.sequential_ms >= 6000 + st.bus_ms);
+    TEST_ASSERT_EQUAL(st.bus_ms * 100 / st.wall_ms, st.utilization);
+
+    /* aC! ×4, D0 ×3 plus D1 for the 20-value sensor */
+    TEST_ASSERT_EQUAL(8, sim.commands);
+}
+
+void test_master_survey_estimated_clock(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 3, 1);
+    sim_add_sensor('1', 2, 0);        /* data ready immediately */
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);              /* no millis callback */
+
+    sdi12_survey_entry_t e[2];
+    memset(e, 0, sizeof(e));
+    e[0].addr = '0';
+    e[1].addr = '1';
+
+    sdi12_survey_stats_t st;
+    uint32_t t0 = sim.now_ms;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_survey(&m, e, 2, &st));
+    TEST_ASSERT_EQUAL(2, st.ok);
+    TEST_ASSERT_TRUE(e[1].done_ms < e[0].done_ms);
+
+    /* Transmit-time estimate tracks the real elapsed time closely */
+    uint32_t real = sim.now_ms - t0;
+    TEST_ASSERT_TRUE(st.wall_ms + 20 >= real && st.wall_ms <= real + 20);
+
+    /* One break at the start, one after the 1 s wait */
+    TEST_ASSERT_EQUAL(2, sim.breaks);
+
+    e[1].addr = '!';
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_ADDRESS, sdi12_master_survey(&m, e, 2, NULL));
+}
+
+/* ── Scheduler ──────────────────────────────────────────────────────────── */
+
+static sdi12_sched_job_t sched_job(char addr, sdi12_meas_type_t type,
+                                   uint16_t ttt, uint8_t values, uint32_t period)
+{
+    sdi12_sched_job_t j;
+    memset(&j, 0, sizeof(j));
+    j.addr = addr;
+    j.type = type;
+    j.ttt_s = ttt;
+    j.values = values;
+    j.period_ms = period;
+    return j;
+}
+
+void test_master_sched_admission(void)
+{
+    sim_reset();
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    sdi12_sched_t sched;
+
+    sdi12_sched_job_t jobs[3];
+    jobs[0] = sched_job('0', SDI12_MEAS_CONCURRENT, 2, 3, 10000);
+    jobs[1] = sched_job('1', SDI12_MEAS_STANDARD, 1, 2, 5000);
+
+    /* aM! holds the bus through ttt; aC! does not */
+    TEST_ASSERT_TRUE(sdi12_sched_job_cost(&jobs[1]) > 1000);
+    TEST_ASSERT_TRUE(sdi12_sched_job_cost(&jobs[0]) < 500);
+    jobs[0].crc = true;
+    jobs[0].values = 20;              /* 3 worst-case C pages */
+    TEST_ASSERT_TRUE(sdi12_sched_job_cost(&jobs[0]) > 1500);
+    jobs[0].crc = false;
+    jobs[0].values = 3;
+
+    /* Needs a clock */
+    TEST_ASSERT_EQUAL(SDI12_ERR_CALLBACK_MISSING, sdi12_sched_init(&sched, &m, jobs, 2));
+    m.cb.millis = sim_millis;
+
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sched_init(&sched, &m, jobs, 2));
+    TEST_ASSERT_TRUE(sched.load_permille > 200 && sched.load_permille < SDI12_SCHED_WARN_PERMILLE);
+
+    /* A 9 s aM! leaves the 5 s job no way to meet its deadline */
+    jobs[2] = sched_job('2', SDI12_MEAS_STANDARD, 9, 1, 60000);
+    TEST_ASSERT_EQUAL(SDI12_ERR_OVERLOAD, sdi12_sched_init(&sched, &m, jobs, 3));
+
+    /* Over 100 % of the bus */
+    jobs[2] = sched_job('2', SDI12_MEAS_STANDARD, 3, 1, 2000);
+    TEST_ASSERT_EQUAL(SDI12_ERR_OVERLOAD, sdi12_sched_init(&sched, &m, jobs + 2, 1));
+
+    jobs[2].period_ms = 0;
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND, sdi12_sched_init(&sched, &m, jobs + 2, 1));
+    jobs[2].addr = '*';
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_ADDRESS, sdi12_sched_init(&sched, &m, jobs + 2, 1));
+}
+
+void test_master_sched_multi_rate(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 3, 2);
+    sim_add_sensor('1', 2, 1);
+    sim_add_sensor('2', 1, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    m.cb.millis = sim_millis;
+
+    sdi12_sched_job_t jobs[3];
+    jobs[0] = sched_job('0', SDI12_MEAS_CONCURRENT, 2, 3, 6000);
+    jobs[1] = sched_job('1', SDI12_MEAS_STANDARD, 1, 2, 3000);
+    jobs[2] = sched_job('2', SDI12_MEAS_STANDARD, 0, 1, 2000);
+
+    sdi12_sched_t sched;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sched_init(&sched, &m, jobs, 3));
+
+    uint32_t end = sim.now_ms + 30000;
+    while ((int32_t)(sim.now_ms - end) < 0) {
+        uint32_t wait = sdi12_sched_poll(&sched);
+        if (wait > end - sim.now_ms) wait = end - sim.now_ms;
+        if (wait > 0) sim_advance(wait);
+    }
+
+    TEST_ASSERT_TRUE(jobs[0].runs >= 4 && jobs[0].runs <= 5);
+    TEST_ASSERT_TRUE(jobs[1].runs >= 9 && jobs[1].runs <= 10);
+    TEST_ASSERT_TRUE(jobs[2].runs >= 14 && jobs[2].runs <= 15);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(SDI12_OK, jobs[i].result);
+        TEST_ASSERT_EQUAL(0, jobs[i].overruns);
+        TEST_ASSERT_EQUAL(0, jobs[i].max_late_ms);
+    }
+    TEST_ASSERT_EQUAL(3, jobs[0].data.value_count);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 21.0f, jobs[1].data.values[1].value);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 30.0f, jobs[2].data.values[0].value);
+}
+
+void test_master_sched_waits_out_ttt(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 2, 2);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    m.cb.millis = sim_millis;
+
+    sdi12_sched_job_t job = sched_job('0', SDI12_MEAS_STANDARD, 2, 2, 10000);
+    sdi12_sched_t sched;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sched_init(&sched, &m, &job, 1));
+
+    /* Another sensor's service request must not cut the wait short */
+    uint32_t t0 = sim.now_ms;
+    sim.foreign_sr_ms = t0 + 500;
+    while (job.runs == 0) sim_advance(sdi12_sched_poll(&sched));
+
+    TEST_ASSERT_EQUAL(0, sim.foreign_sr_ms);
+    TEST_ASSERT_TRUE(sim.now_ms - t0 >= 2000);
+    TEST_ASSERT_EQUAL(SDI12_OK, job.result);
+    TEST_ASSERT_EQUAL(2, job.data.value_count);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 11.0f, job.data.values[1].value);
+}
+
+/* ── Exact Decimal Values ───────────────────────────────────────────────── */
+
+void test_master_get_data_decimal_exact(void)
+{
+    sim_reset();
+    sim_sensor_t *s = sim_add_sensor('0', 4, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    /* Concurrent measurement finished with exact values (no service request) */
+    s->ctx.state = SDI12_STATE_MEASURING_C;
+    const sdi12_decimal_t sent[4] = {
+        {99999999, 0}, {100, 3}, {-5, 3}, {1234567, 3}
+    };
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_measurement_done_decimal(&s->ctx, sent, 4));
+
+    sdi12_decimal_t got[SDI12_MAX_VALUES];
+    uint8_t count = 0;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_data_decimal(&m, '0', 0, false,
+                                                              got, SDI12_MAX_VALUES, &count));
+    TEST_ASSERT_EQUAL(4, count);
+    for (uint8_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(sent[i].mantissa, got[i].mantissa);
+        TEST_ASSERT_EQUAL(sent[i].decimals, got[i].decimals);
+    }
+
+    /* The float API reads the same page */
+    sdi12_data_response_t d;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_data(&m, '0', 0, false, &d));
+    TEST_ASSERT_EQUAL(4, d.value_count);
+    TEST_ASSERT_EQUAL_FLOAT(1234.567f, d.values[3].value);
+    TEST_ASSERT_EQUAL(3, d.values[1].decimals);
+}
+
+/* ── CRC Verified While Parsing ─────────────────────────────────────────── */
+
+void test_master_crc_verified_in_parse(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 3, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    sdi12_meas_response_t meas;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_start_measurement(&m, '0', SDI12_MEAS_STANDARD,
+                                                               0, true, &meas));
+    sdi12_data_response_t d;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_data(&m, '0', 0, true, &d));
+    TEST_ASSERT_TRUE(d.crc_valid);
+    TEST_ASSERT_EQUAL(3, d.value_count);
+    TEST_ASSERT_EQUAL_FLOAT(12.0f, d.values[2].value);   /* CRC chars not parsed */
+
+    /* One digit flipped on the wire still parses, but fails the CRC */
+    sim.corrupt_replies = 1;
+    TEST_ASSERT_EQUAL(SDI12_ERR_CRC_MISMATCH, sdi12_master_get_data(&m, '0', 0, true, &d));
+    TEST_ASSERT_FALSE(d.crc_valid);
+
+    sdi12_decimal_t dec[SDI12_MAX_VALUES];
+    uint8_t count = 0;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_data_decimal(&m, '0', 0, true, dec,
+                                                              SDI12_MAX_VALUES, &count));
+    TEST_ASSERT_EQUAL(3, count);
+    sim.corrupt_replies = 1;
+    TEST_ASSERT_EQUAL(SDI12_ERR_CRC_MISMATCH,
+                      sdi12_master_get_data_decimal(&m, '0', 0, true, dec,
+                                                    SDI12_MAX_VALUES, &count));
+
+    /* aRC0! */
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_continuous(&m, '0', 0, true, &d));
+    TEST_ASSERT_TRUE(d.crc_valid);
+    TEST_ASSERT_EQUAL(3, d.value_count);
+    sim.corrupt_replies = 1;
+    TEST_ASSERT_EQUAL(SDI12_ERR_CRC_MISMATCH, sdi12_master_continuous(&m, '0', 0, true, &d));
+
+    /* Without CRC nothing is checked or stripped */
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_continuous(&m, '0', 0, false, &d));
+    TEST_ASSERT_FALSE(d.crc_valid);
+    TEST_ASSERT_EQUAL(3, d.value_count);
+    TEST_ASSERT_EQUAL_FLOAT(12.0f, d.values[2].value);
+}
+
+/* ── Zero-Copy Views ────────────────────────────────────────────────────── */
+
+static sdi12_err_t sim_xcmd_gain(const char *xcmd, char *resp, size_t size, void *ud)
+{
+    (void)xcmd; (void)ud;
+    size_t pos = strlen(resp);
+    snprintf(resp + pos, size - pos, "GAIN=2.50");
+    return SDI12_OK;
+}
+
+void test_master_response_views(void)
+{
+    sim_reset();
+    sim_sensor_t *s = sim_add_sensor('0', 3, 0);
+    sdi12_sensor_register_xcmd(&s->ctx, "G", sim_xcmd_gain);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    /* aI! fields point into the receive buffer */
+    sdi12_ident_view_t id;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_identify_view(&m, '0', &id));
+    TEST_ASSERT_EQUAL_CHAR('0', id.address);
+    TEST_ASSERT_TRUE(id.vendor.ptr == m.resp_buf + 3);
+    TEST_ASSERT_EQUAL(8, id.vendor.len);
+    TEST_ASSERT_EQUAL(0, memcmp(id.vendor.ptr, "SIMBUS  ", 8));
+    TEST_ASSERT_EQUAL(0, memcmp(id.model.ptr, "SIM001", 6));
+    TEST_ASSERT_EQUAL(0, memcmp(id.firmware.ptr, "100", 3));
+    TEST_ASSERT_EQUAL(0, id.serial.len);
+
+    /* The copying call gives the same fields */
+    sdi12_ident_t ident;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_identify(&m, '0', &ident));
+    TEST_ASSERT_EQUAL_STRING("SIM001", ident.model);
+
+    /* Per-value text exactly as sent */
+    sdi12_meas_response_t meas;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_start_measurement(&m, '0', SDI12_MEAS_STANDARD,
+                                                               0, true, &meas));
+    sdi12_span_t vals[SDI12_MAX_VALUES];
+    uint8_t count = 0;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_data_view(&m, '0', 0, true, vals,
+                                                           SDI12_MAX_VALUES, &count));
+    TEST_ASSERT_EQUAL(3, count);
+    TEST_ASSERT_TRUE(vals[0].ptr == m.resp_buf + 1);
+    TEST_ASSERT_EQUAL(5, vals[2].len);
+    TEST_ASSERT_EQUAL(0, memcmp(vals[2].ptr, "+12.0", 5));
+
+    /* Whole page, CRC included, no length cap */
+    sdi12_span_t page;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_hv_data_view(&m, '0', 0, &page));
+    TEST_ASSERT_EQUAL(15 + 3, page.len);
+    TEST_ASSERT_EQUAL(0, memcmp(page.ptr, "+10.0+11.0+12.0", 15));
+
+    /* aX reply, verbatim through CR/LF */
+    sdi12_span_t x;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_extended_view(&m, '0', "G", &x, 100));
+    TEST_ASSERT_EQUAL(12, x.len);
+    TEST_ASSERT_EQUAL(0, memcmp(x.ptr, "0GAIN=2.50\r\n", 12));
+
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_master_get_data_view(&m, '0', 0, false, NULL, 1, &count));
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_ADDRESS,
+                      sdi12_master_extended_view(&m, '#', "G", &x, 100));
+}
+
+/* ── Text Pass-Through ──────────────────────────────────────────────────── */
+
+static struct {
+    char     text[12][12];
+    uint8_t  decimals[12];
+    uint16_t count;
+} text_log;
+
+static void text_sink(char addr, const sdi12_value_text_t *v, void *ud)
+{
+    (void)addr; (void)ud;
+    TEST_ASSERT_EQUAL(text_log.count, v->index);
+    if (text_log.count >= 12 || v->text.len >= 12) return;
+    memcpy(text_log.text[text_log.count], v->text.ptr, v->text.len);
+    text_log.text[text_log.count][v->text.len] = '\0';
+    text_log.decimals[text_log.count] = v->decimals;
+    text_log.count++;
+}
+
+void test_master_collect_text_passthrough(void)
+{
+    sim_reset();
+    sim_sensor_t *s = sim_add_sensor('0', 8, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    /* 47 value chars: two aM! pages of at most 35 */
+    const sdi12_decimal_t sent[8] = {
+        {100, 3}, {-40, 0}, {99999999, 0}, {5, 2},
+        {-1234567, 3}, {0, 1}, {12345678, 0}, {7, 0}
+    };
+    const char *expect[8] = {
+        "+0.100", "-40", "+99999999", "+0.05",
+        "-1234.567", "+0.0", "+12345678", "+7"
+    };
+    s->ctx.state = SDI12_STATE_MEASURING_C;
+    sdi12_sensor_measurement_done_decimal(&s->ctx, sent, 8);
+
+    sdi12_meas_response_t meas;
+    memset(&meas, 0, sizeof(meas));
+    meas.address = '0';
+    meas.value_count = 8;
+
+    memset(&text_log, 0, sizeof(text_log));
+    uint32_t before = sim.commands;
+    uint16_t n = 0;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_collect_text(&m, '0', &meas, false,
+                                                          text_sink, NULL, &n));
+    TEST_ASSERT_EQUAL(8, n);
+    TEST_ASSERT_EQUAL(2, sim.commands - before);
+    for (uint8_t i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_STRING(expect[i], text_log.text[i]);
+        TEST_ASSERT_EQUAL(sent[i].decimals, text_log.decimals[i]);
+    }
+
+    /* With CRC: good pages pass, a damaged first page emits nothing */
+    s->ctx.crc_requested = true;
+    memset(&text_log, 0, sizeof(text_log));
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_collect_text(&m, '0', &meas, true,
+                                                          text_sink, NULL, &n));
+    TEST_ASSERT_EQUAL_STRING("+7", text_log.text[7]);
+
+    memset(&text_log, 0, sizeof(text_log));
+    sim.corrupt_replies = 1;
+    TEST_ASSERT_EQUAL(SDI12_ERR_CRC_MISMATCH,
+                      sdi12_master_collect_text(&m, '0', &meas, true, text_sink, NULL, &n));
+    TEST_ASSERT_EQUAL(0, n);
+    TEST_ASSERT_EQUAL(0, text_log.count);
+
+    /* Sensor runs short */
+    meas.value_count = 9;
+    TEST_ASSERT_EQUAL(SDI12_ERR_NO_DATA,
+                      sdi12_master_collect_text(&m, '0', &meas, true, text_sink, NULL, &n));
+    TEST_ASSERT_EQUAL(8, n);
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_master_collect_text(&m, '0', &meas, true, NULL, NULL, &n));
+}
+
+/* ── Compact Data Container ─────────────────────────────────────────────── */
+
+void test_master_collect_soa_aggregates(void)
+{
+    sim_reset();
+    sim_add_sensor('0', 3, 0);
+    sim_add_sensor('1', 2, 0);
+    sim_add_sensor('2', 3, 0);
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    float vals[8];
+    uint8_t dec[8];
+    uint8_t quality[SDI12_SOA_QUALITY_BYTES(8)];
+    sdi12_data_soa_t d;
+    sdi12_data_soa_init(&d, vals, dec, quality, 8);
+
+    /* Three sensors back to back; only '1' uses CRC */
+    const char addrs[3] = {'0', '1', '2'};
+    for (uint8_t i = 0; i < 3; i++) {
+        bool crc = addrs[i] == '1';
+        sdi12_meas_response_t meas;
+        TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_start_measurement(
+            &m, addrs[i], SDI12_MEAS_STANDARD, 0, crc, &meas));
+        TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_collect_soa(&m, addrs[i], &meas, crc, &d));
+    }
+
+    const float expect[8] = {10, 11, 12, 20, 21, 30, 31, 32};
+    TEST_ASSERT_EQUAL(8, d.count);
+    for (uint16_t i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(expect[i], vals[i]);
+        TEST_ASSERT_EQUAL(1, dec[i]);
+        TEST_ASSERT_EQUAL(i == 3 || i == 4, sdi12_soa_verified(&d, i));
+    }
+
+    /* Full: refused before anything goes on the bus */
+    sdi12_meas_response_t more;
+    memset(&more, 0, sizeof(more));
+    more.value_count = 1;
+    uint32_t before = sim.commands;
+    TEST_ASSERT_EQUAL(SDI12_ERR_BUFFER_OVERFLOW, sdi12_master_collect_soa(&m, '0', &more, false, &d));
+    TEST_ASSERT_EQUAL(before, sim.commands);
+
+    /* Columns are optional; a 3-value result needs 12 bytes of floats */
+    float small[3];
+    sdi12_data_soa_init(&d, small, NULL, NULL, 3);
+    more.value_count = 3;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_collect_soa(&m, '2', &more, false, &d));
+    TEST_ASSERT_EQUAL_FLOAT(32.0f, small[2]);
+    TEST_ASSERT_FALSE(sdi12_soa_verified(&d, 0));
+    TEST_ASSERT_TRUE(sizeof(sdi12_data_response_t) > 60 * sizeof(small));
+}
+
+/* ── High-Volume Binary Receive ─────────────────────────────────────────── */
+
+/** DB page: 24 int16 values, page number in the first, LF and CR bytes inside. */
+static size_t bin_page(uint16_t page, const sdi12_value_t *values, uint8_t count,
+                       char *buf, size_t buflen, void *ud)
+{
+    (void)values; (void)count; (void)ud;
+    if (page > 1 || buflen < 2 + 48) return 0;
+    buf[1] = (char)SDI12_BINTYPE_INT16;
+    for (uint8_t i = 0; i < 24; i++) {
+        int16_t v = i == 0 ? (int16_t)page : (int16_t)(0x0A0D + i * 257);
+        buf[2 + 2 * i]     = (char)(v & 0xFF);
+        buf[2 + 2 * i + 1] = (char)((uint16_t)v >> 8);
+    }
+    return 1 + 48;
+}
+
+void test_master_hv_binary_streamed(void)
+{
+    sim_reset();
+    sim_sensor_t *s = sim_add_sensor('0', 3, 0);
+    s->ctx.cb.format_binary_page = bin_page;
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+
+    sdi12_meas_response_t meas;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_start_measurement(
+        &m, '0', SDI12_MEAS_HIGHVOL_BINARY, 0, false, &meas));
+
+    char expect[50];
+    TEST_ASSERT_EQUAL(49, bin_page(1, NULL, 0, expect, sizeof(expect), NULL));
+
+    uint8_t payload[64];
+    sdi12_bintype_t type = SDI12_BINTYPE_INVALID;
+    size_t len = sizeof(payload);
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_hv_binary_data(
+        &m, '0', 1, &type, payload, &len));
+    TEST_ASSERT_EQUAL(SDI12_BINTYPE_INT16, type);
+    TEST_ASSERT_EQUAL(48, len);
+    TEST_ASSERT_EQUAL(0, memcmp(payload, expect + 2, 48));
+    TEST_ASSERT_EQUAL(SDI12_BIN_PKT_OVERHEAD + 48, m.resp_len);
+
+    /* Small buffer: the rest is read and checked but not stored */
+    memset(payload, 0xEE, sizeof(payload));
+    len = 5;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_hv_binary_data(
+        &m, '0', 1, &type, payload, &len));
+    TEST_ASSERT_EQUAL(48, len);
+    TEST_ASSERT_EQUAL(0, memcmp(payload, expect + 2, 5));
+    TEST_ASSERT_EQUAL(0xEE, payload[5]);
+    TEST_ASSERT_EQUAL(0, sim.rx_len);
+
+    /* The bus is still in step: the next page reads cleanly */
+    len = sizeof(payload);
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_hv_binary_data(
+        &m, '0', 0, &type, payload, &len));
+    TEST_ASSERT_EQUAL(0, payload[0] | payload[1]);
+
+    /* Past the last page: an empty packet */
+    len = sizeof(payload);
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_hv_binary_data(
+        &m, '0', 2, &type, payload, &len));
+    TEST_ASSERT_EQUAL(0, len);
+    TEST_ASSERT_EQUAL(SDI12_BINTYPE_INVALID, type);
+}
+
+/* ── High-Volume Collection ─────────────────────────────────────────────── */
+
+static struct {
+    uint16_t order[128];
+    uint16_t count;
+    bool     ahead;     /**< Every page but the last saw the next command out. */
+    uint32_t base;      /**< sim.commands before the collection. */
+} hv_log;
+
+static void hv_sink(char addr, uint16_t page, const sdi12_hv_arena_t *a, void *ud)
+{
+    (void)addr; (void)ud;
+    if (hv_log.count < 128) hv_log.order[hv_log.count] = page;
+    hv_log.count++;
+    if (page + 1u < a->page_count && sim.commands - hv_log.base < page + 2u) {
+        hv_log.ahead = false;
+    }
+}
+
+void test_master_collect_hv_pipelined(void)
+{
+    sim_reset();
+    sim_sensor_t *s = sim_add_sensor('0', 1, 0);
+    static sdi12_history_rec_t recs[600];
+    sdi12_sensor_attach_history(&s->ctx, 0, recs, 600, 1000);
+    for (uint32_t t = 0; t < 700; t++) sdi12_sensor_tick(&s->ctx, t * 1000u);
+
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    char xr[16];
+    size_t xlen = sizeof(xr);
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_extended(&m, '0', "HIST0,0,999", xr, &xlen,
+                                                      SDI12_RESPONSE_TIMEOUT_MS));
+
+    /* HA with CRC; page 0 arrives damaged and is the only one asked again */
+    sdi12_meas_response_t meas;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_start_measurement(
+        &m, '0', SDI12_MEAS_HIGHVOL_ASCII, 0, true, &meas));
+    TEST_ASSERT_EQUAL(998, meas.value_count);
+
+    static uint8_t buf[8192];
+    static sdi12_hv_page_t pages[128];
+    sdi12_hv_arena_t a;
+    sdi12_hv_arena_init(&a, buf, sizeof(buf), pages, 128);
+
+    memset(&hv_log, 0, sizeof(hv_log));
+    hv_log.ahead = true;
+    hv_log.base = sim.commands;
+    uint32_t breaks = sim.breaks;
+    sim.corrupt_replies = 1;
+    sdi12_hv_stats_t st;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_collect_hv(&m, '0', &meas, true, &a,
+                                                       hv_sink, NULL, &st));
+    TEST_ASSERT_EQUAL(998, a.value_count);
+    TEST_ASSERT_TRUE(a.page_count > 10);
+    TEST_ASSERT_EQUAL(a.page_count, st.pages);
+    TEST_ASSERT_EQUAL(1, st.retried);
+    TEST_ASSERT_EQUAL(0, st.failed);
+    /* Every page once, page 0 again, and the empty page that ended the walk
+     * because page 0's values were still missing */
+    TEST_ASSERT_EQUAL(a.page_count + 2u, sim.commands - hv_log.base);
+    TEST_ASSERT_EQUAL(breaks, sim.breaks);
+    TEST_ASSERT_EQUAL(0, st.breaks);
+    TEST_ASSERT_TRUE(st.pages_per_sec > 0);
+    TEST_ASSERT_TRUE(hv_log.ahead);
+    TEST_ASSERT_EQUAL(a.page_count, hv_log.count);
+    TEST_ASSERT_EQUAL(1, hv_log.order[0]);
+    TEST_ASSERT_EQUAL(0, hv_log.order[a.page_count - 1]);
+
+    /* Stored text is the page without address and CRC */
+    for (uint16_t p = 0; p < a.page_count; p += 7) {
+        sdi12_span_t view;
+        TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_hv_data_view(&m, '0', p, &view));
+        TEST_ASSERT_EQUAL(view.len - 3, pages[p].len);
+        TEST_ASSERT_EQUAL(0, memcmp(view.ptr, buf + pages[p].offset, pages[p].len));
+    }
+
+    /* Same range as HB FLOAT32 pairs; page 0 times out once */
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_start_measurement(
+        &m, '0', SDI12_MEAS_HIGHVOL_BINARY, 0, false, &meas));
+    sim.corrupt_replies = 1;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_collect_hv(&m, '0', &meas, false, &a,
+                                                       NULL, NULL, &st));
+    TEST_ASSERT_EQUAL(998, a.value_count);
+    TEST_ASSERT_EQUAL(1, st.retried);
+    TEST_ASSERT_EQUAL(SDI12_BINTYPE_FLOAT32, pages[0].type);
+    TEST_ASSERT_EQUAL(a.value_count * 4u, a.used);
+    float age;
+    memcpy(&age, buf + pages[0].offset, sizeof(age));   /* LE host assumed */
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 498.0f, age);
+
+    /* Arena too small: stops at the page that does not fit */
+    sdi12_hv_arena_init(&a, buf, 100, pages, 128);
+    TEST_ASSERT_EQUAL(SDI12_ERR_BUFFER_OVERFLOW,
+                      sdi12_master_collect_hv(&m, '0', &meas, false, &a, NULL, NULL, NULL));
+    TEST_ASSERT_TRUE(a.used <= 100);
+}
+
+/* ── High-Volume ASCII Values ───────────────────────────────────────────── */
+
+void test_master_collect_ha_values(void)
+{
+    sim_reset();
+    sim_sensor_t *s = sim_add_sensor('0', 1, 0);
+    static sdi12_history_rec_t recs[600];
+    sdi12_sensor_attach_history(&s->ctx, 0, recs, 600, 1000);
+    for (uint32_t t = 0; t < 700; t++) sdi12_sensor_tick(&s->ctx, t * 1000u);
+
+    sdi12_master_ctx_t m;
+    sim_master_init(&m);
+    char xr[16];
+    size_t xlen = sizeof(xr);
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_extended(&m, '0', "HIST0,0,999", xr, &xlen,
+                                                      SDI12_RESPONSE_TIMEOUT_MS));
+    sdi12_meas_response_t meas;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_start_measurement(
+        &m, '0', SDI12_MEAS_HIGHVOL_ASCII, 0, true, &meas));
+    TEST_ASSERT_EQUAL(998, meas.value_count);
+
+    /* All 998 values in one array; page 0 arrives damaged */
+    static sdi12_value_t vals[1000];
+    uint16_t n = 0;
+    uint32_t base = sim.commands, breaks = sim.breaks;
+    sim.corrupt_replies = 1;
+    sdi12_hv_stats_t st;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_collect_ha_values(&m, '0', &meas, true,
+                                                              vals, 1000, &n, &st));
+    TEST_ASSERT_EQUAL(998, n);
+    TEST_ASSERT_TRUE(st.pages > 10);
+    TEST_ASSERT_EQUAL(1, st.retried);
+    TEST_ASSERT_EQUAL(0, st.failed);
+    TEST_ASSERT_EQUAL(breaks, sim.breaks);
+    /* Every page once; page 0 again, and page 1 that was already asked */
+    TEST_ASSERT_EQUAL(st.pages + 2u, sim.commands - base);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 498.0f, vals[0].value);
+
+    /* Same values, in order, as parsing each page on its own */
+    uint16_t at = 0;
+    for (uint16_t p = 0; p < st.pages; p++) {
+        sdi12_span_t view;
+        sdi12_value_t pv[SDI12_MAX_VALUES];
+        uint8_t pn = 0;
+        TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_get_hv_data_view(&m, '0', p, &view));
+        TEST_ASSERT_EQUAL(SDI12_OK, sdi12_master_parse_data_values(view.ptr, view.len, pv,
+                                                                   SDI12_MAX_VALUES, &pn, true));
+        for (uint8_t i = 0; i < pn; i++, at++) {
+            TEST_ASSERT_EQUAL(0, memcmp(&pv[i].value, &vals[at].value, sizeof(float)));
+            TEST_ASSERT_EQUAL(pv[i].decimals, vals[at].decimals);
+        }
+    }
+    TEST_ASSERT_EQUAL(998, at);
+
+    /* Array too small: the first 100 values, then stop */
+    TEST_ASSERT_EQUAL(SDI12_ERR_BUFFER_OVERFLOW,
+                      sdi12_master_collect_ha_values(&m, '0', &meas, true, vals, 100, &n, NULL));
+    TEST_ASSERT_EQUAL(100, n);
+
+    /* The raw copy reports truncation instead of hiding it */
+    char raw[8];
+    size_t raw_len = sizeof(raw);
+    TEST_ASSERT_EQUAL(SDI12_ERR_BUFFER_OVERFLOW,
+                      sdi12_master_get_hv_data(&m, '0', 0, raw, &raw_len));
+    TEST_ASSERT_EQUAL(sizeof(raw), raw_len);
+}
+
+/* ── Binary Payload Decoding ────────────────────────────────────────────── */
+
+/** Append `size` bytes of `bits`, least significant first, as on the wire. */
+static size_t put_le(uint8_t *p, uint64_t bits, size_t size)
+{
+    for (size_t b = 0; b < size; b++) p[b] = (uint8_t)(bits >> (8 * b));
+    return size;
+}
+
+void test_bin_decode_all_types(void)
+{
+    uint8_t pay[SDI12_BIN_MAX_PAYLOAD];
+    float f[128];
+    double d[128];
+    int64_t q[128];
+
+    /* int16: 19 values, so the vector loop leaves a tail */
+    size_t len = 0;
+    for (int i = 0; i < 19; i++) len += put_le(pay + len, (uint16_t)(int16_t)(i * 3001 - 32000), 2);
+    TEST_ASSERT_EQUAL(19, sdi12_bin_decode_float(SDI12_BINTYPE_INT16, pay, len, f, 128));
+    TEST_ASSERT_EQUAL(19, sdi12_bin_decode_int64(SDI12_BINTYPE_INT16, pay, len, q, 128));
+    for (int i = 0; i < 19; i++) {
+        TEST_ASSERT_EQUAL_FLOAT((float)(i * 3001 - 32000), f[i]);
+        TEST_ASSERT_EQUAL(i * 3001 - 32000, (int)q[i]);
+    }
+    TEST_ASSERT_EQUAL(19, sdi12_bin_decode_float(SDI12_BINTYPE_UINT16, pay, len, f, 128));
+    TEST_ASSERT_EQUAL_FLOAT(33536.0f, f[0]);   /* 0x8300 unsigned */
+
+    /* int32 and float32: 11 values each, capped and misaligned */
+    len = 0;
+    for (int i = 0; i < 11; i++) len += put_le(pay + 1 + len, (uint32_t)(int32_t)(i * -199999 + 7), 4);
+    TEST_ASSERT_EQUAL(11, sdi12_bin_decode_float(SDI12_BINTYPE_INT32, pay + 1, len, f, 128));
+    TEST_ASSERT_EQUAL(11, sdi12_bin_decode_double(SDI12_BINTYPE_INT32, pay + 1, len, d, 128));
+    for (int i = 0; i < 11; i++) {
+        TEST_ASSERT_EQUAL_FLOAT((float)(i * -199999 + 7), f[i]);
+        TEST_ASSERT_TRUE(d[i] == (double)(i * -199999 + 7));
+    }
+    TEST_ASSERT_EQUAL(5, sdi12_bin_decode_float(SDI12_BINTYPE_INT32, pay + 1, len, f, 5));
+
+    len = 0;
+    for (int i = 0; i < 11; i++) {
+        float v = (float)i * -1.25f + 0.1f;
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        len += put_le(pay + len, bits, 4);
+    }
+    TEST_ASSERT_EQUAL(11, sdi12_bin_decode_float(SDI12_BINTYPE_FLOAT32, pay, len + 3, f, 128));
+    TEST_ASSERT_EQUAL(11, sdi12_bin_decode_int64(SDI12_BINTYPE_FLOAT32, pay, len, q, 128));
+    for (int i = 0; i < 11; i++) {
+        float v = (float)i * -1.25f + 0.1f;
+        TEST_ASSERT_EQUAL(0, memcmp(&v, &f[i], sizeof(v)));
+    }
+    TEST_ASSERT_EQUAL(-1, (int)q[1]);     /* -1.15 */
+    TEST_ASSERT_EQUAL(-12, (int)q[10]);   /* -12.4 */
+
+    /* 8-bit and 64-bit types */
+    pay[0] = 0xFF;
+    TEST_ASSERT_EQUAL(1, sdi12_bin_decode_int64(SDI12_BINTYPE_INT8, pay, 1, q, 1));
+    TEST_ASSERT_EQUAL(-1, (int)q[0]);
+    TEST_ASSERT_EQUAL(1, sdi12_bin_decode_int64(SDI12_BINTYPE_UINT8, pay, 1, q, 1));
+    TEST_ASSERT_EQUAL(255, (int)q[0]);
+
+    put_le(pay, (uint64_t)-5000000000LL, 8);
+    put_le(pay + 8, UINT64_MAX, 8);
+    TEST_ASSERT_EQUAL(2, sdi12_bin_decode_int64(SDI12_BINTYPE_INT64, pay, 16, q, 128));
+    TEST_ASSERT_TRUE(q[0] == -5000000000LL && q[1] == -1);
+    TEST_ASSERT_EQUAL(2, sdi12_bin_decode_int64(SDI12_BINTYPE_UINT64, pay, 16, q, 128));
+    TEST_ASSERT_TRUE(q[1] == INT64_MAX);
+
+    const double dv[3] = { 2.5, -1e300, 123456789.125 };
+    for (int i = 0; i < 3; i++) {
+        uint64_t bits;
+        memcpy(&bits, &dv[i], sizeof(bits));
+        put_le(pay + 8 * i, bits, 8);
+    }
+    TEST_ASSERT_EQUAL(3, sdi12_bin_decode_double(SDI12_BINTYPE_FLOAT64, pay, 24, d, 128));
+    TEST_ASSERT_TRUE(d[0] == 2.5 && d[1] == -1e300 && d[2] == 123456789.125);
+    TEST_ASSERT_EQUAL(3, sdi12_bin_decode_int64(SDI12_BINTYPE_FLOAT64, pay, 24, q, 128));
+    TEST_ASSERT_TRUE(q[0] == 3 && q[1] == INT64_MIN && q[2] == 123456789);
+
+    /* Nothing to decode */
+    TEST_ASSERT_EQUAL(0, sdi12_bin_decode_float(SDI12_BINTYPE_INVALID, pay, 24, f, 128));
+    TEST_ASSERT_EQUAL(0, sdi12_bin_decode_float(SDI12_BINTYPE_INT32, pay, 3, f, 128));
+    TEST_ASSERT_EQUAL(0, sdi12_bin_decode_double(SDI12_BINTYPE_INT16, NULL, 4, d, 128));
+}
@@ -19,6 +19,11 @@
  *   - Extended commands (aX!)
  *   - Metadata commands (aIM!, aIM_001!)
  *   - Parameter registration limits
+ *   - Background sampler (aR!/aM! served from the sample ring)
+ *   - Predictive pre-measurement (learned poll cadence)
+ *   - Shared acquisition across measurement groups
+ *   - Streaming statistics (mean/min/max/stddev/count)
+ *   - Sample history with bulk aHA!/aHB! download
  */
 #include "sdi12_test.h"
 #include <stdio.h>
@@ -33,6 +38,7 @@ size_t mock_response_len;
 sdi12_dir_t mock_direction;
 char mock_saved_address;
 int mock_send_count;
+int mock_read_count;
 
 void mock_send_response(const char *data, size_t len, void *user_data)
 {
@@ -54,6 +60,7 @@ sdi12_value_t mock_read_param(uint8_t param_index, void *user_data)
 {
     (void)user_data;
     sdi12_value_t val = {0.0f, 0};
+    mock_read_count++;
     switch (param_index) {
     case 0: val.value = 42.0f;    val.decimals = 0; break;  /* Lux */
     case 1: val.value = 25.50f;   val.decimals = 2; break;  /* Temp */
@@ -84,6 +91,7 @@ void reset_mocks(void)
     mock_direction = SDI12_DIR_RX;
     mock_saved_address = '\0';
     mock_send_count = 0;
+    mock_read_count = 0;
 }
 
 /** Create a standard test context with 5 params in group 0. */
@@ -385,6 +393,27 @@ void test_sensor_send_data_no_data(void)
     TEST_ASSERT_EQUAL_CHAR('0', mock_response[0]);
 }
 
+void test_sensor_send_data_second_page(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+
+    /* Five more "+0" values overflow the 35-char M page by one value */
+    for (int i = 0; i < 5; i++) {
+        sdi12_sensor_register_param(&ctx, 0, "ZZ", "u", 0);
+    }
+    sdi12_sensor_process(&ctx, "0M!", 3);
+
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+42+25.50+101.3+65.00-10.5+0+0+0+0\r\n", mock_response);
+
+    sdi12_sensor_process(&ctx, "0D1!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+0\r\n", mock_response);
+
+    sdi12_sensor_process(&ctx, "0D2!", 4);
+    TEST_ASSERT_EQUAL_STRING("0\r\n", mock_response);
+}
+
 /* ── Continuous Measurement (aR0!) ──────────────────────────────────────── */
 
 void test_sensor_continuous_r0(void)
@@ -652,6 +681,32 @@ void test_sensor_measurement_done_concurrent_no_sr(void)
     TEST_ASSERT_EQUAL(0, mock_send_count);
 }
 
+void test_sensor_measurement_done_decimal(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    ctx.state = SDI12_STATE_MEASURING_C;
+
+    /* Exact values keep every digit, trailing zeros included */
+    sdi12_decimal_t vals[3] = { {99999999, 0}, {100, 3}, {-5, 3} };
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_measurement_done_decimal(&ctx, vals, 3));
+    TEST_ASSERT_EQUAL(SDI12_STATE_DATA_READY, ctx.state);
+
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+99999999+0.100-0.005\r\n", mock_response);
+
+    /* Float values are rounded, not truncated, at zero decimals */
+    reset_mocks();
+    ctx.state = SDI12_STATE_MEASURING_C;
+    sdi12_value_t fvals[2] = { {12.7f, 0}, {-1234.567f, 3} };
+    sdi12_sensor_measurement_done(&ctx, fvals, 2);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+13-1234.567\r\n", mock_response);
+
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_sensor_measurement_done_decimal(&ctx, NULL, 1));
+}
+
 /* ── Negative Value Formatting ──────────────────────────────────────────── */
 
 void test_sensor_negative_value_in_data(void)
@@ -667,3 +722,610 @@ void test_sensor_negative_value_in_data(void)
     /* Response should contain '-' for the negative value */
     TEST_ASSERT_NOT_NULL(strchr(mock_response, '-'));
 }
+
+/* ── Background Sampler ─────────────────────────────────────────────────── */
+
+void test_sensor_sampler_serves_continuous(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_set_sampler(&ctx, 0, 1000, 0));
+    sdi12_sensor_tick(&ctx, 0);
+    TEST_ASSERT_EQUAL(5, mock_read_count);
+
+    /* aR0! and aM! are answered from the ring — no further reads */
+    sdi12_sensor_process(&ctx, "0R0!", 4);
+    TEST_ASSERT_EQUAL(5, mock_read_count);
+    TEST_ASSERT_EQUAL_STRING("0+42+25.50+101.3+65.00-10.5\r\n", mock_response);
+
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    TEST_ASSERT_EQUAL(5, mock_read_count);
+    TEST_ASSERT_EQUAL_STRING("00005\r\n", mock_response);
+    TEST_ASSERT_EQUAL(5, ctx.data_cache_count);
+}
+
+void test_sensor_sampler_period_refresh(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+
+    sdi12_sensor_set_sampler(&ctx, 0, 1000, 0);
+    sdi12_sensor_tick(&ctx, 0xFFFFFF00u);    /* just before wrap-around */
+    TEST_ASSERT_EQUAL(5, mock_read_count);
+
+    sdi12_sensor_tick(&ctx, 0xFFFFFF00u + 999u);
+    TEST_ASSERT_EQUAL(5, mock_read_count);
+
+    sdi12_sensor_tick(&ctx, 0xFFFFFF00u + 1000u);
+    TEST_ASSERT_EQUAL(10, mock_read_count);
+    TEST_ASSERT_EQUAL(0xFFFFFF00u + 1000u, ctx.samplers[0].sampled_at_ms);
+}
+
+void test_sensor_sampler_max_age_falls_back(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+
+    sdi12_sensor_set_sampler(&ctx, 0, 10000, 500);
+    sdi12_sensor_tick(&ctx, 0);
+    sdi12_sensor_tick(&ctx, 600);            /* sample is now 600 ms old */
+    TEST_ASSERT_EQUAL(5, mock_read_count);
+
+    sdi12_sensor_process(&ctx, "0R0!", 4);
+    TEST_ASSERT_EQUAL(10, mock_read_count);  /* stale → synchronous read */
+
+    /* Unsampled groups and bad group numbers */
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_sensor_set_sampler(&ctx, SDI12_MAX_MEAS_GROUPS, 1000, 0));
+}
+
+/* ── Predictive Pre-measurement ─────────────────────────────────────────── */
+
+static int mock_start_count;
+
+static uint16_t mock_start_3s(uint8_t group, sdi12_meas_type_t type,
+                              void *user_data)
+{
+    (void)group; (void)type; (void)user_data;
+    mock_start_count++;
+    return 3;
+}
+
+/** Poll aM! at a fixed 10 s cadence so the predictor locks on. */
+static void poll_cadence(sdi12_sensor_ctx_t *ctx, int polls)
+{
+    for (int i = 0; i < polls; i++) {
+        sdi12_sensor_tick(ctx, (uint32_t)i * 10000u);
+        sdi12_sensor_process(ctx, "0M!", 3);
+    }
+}
+
+void test_sensor_predict_sync_hit(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    sdi12_sensor_set_prediction(&ctx, true, 100);
+
+    poll_cadence(&ctx, 4);
+    TEST_ASSERT_EQUAL(20, mock_read_count);
+    TEST_ASSERT_EQUAL(10000, ctx.predictors[0].interval_ms);
+
+    /* Lead window opens 100 ms before the expected poll */
+    sdi12_sensor_tick(&ctx, 39800);
+    TEST_ASSERT_EQUAL(20, mock_read_count);
+    sdi12_sensor_tick(&ctx, 39900);
+    TEST_ASSERT_EQUAL(25, mock_read_count);
+
+    sdi12_sensor_tick(&ctx, 40000);
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    TEST_ASSERT_EQUAL_STRING("00005\r\n", mock_response);
+    TEST_ASSERT_EQUAL(25, mock_read_count);
+
+    const sdi12_predict_stats_t *st = sdi12_sensor_get_predict_stats(&ctx);
+    TEST_ASSERT_EQUAL(5, st->polls);
+    TEST_ASSERT_EQUAL(1, st->hits);
+    TEST_ASSERT_EQUAL(1, st->prefetches);
+}
+
+void test_sensor_predict_async_prefetch(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    ctx.cb.start_measurement = mock_start_3s;
+    mock_start_count = 0;
+    sdi12_sensor_set_prediction(&ctx, true, 500);
+
+    sdi12_value_t vals[2] = {{1.5f, 1}, {2.0f, 0}};
+    for (int i = 0; i < 4; i++) {
+        sdi12_sensor_tick(&ctx, (uint32_t)i * 10000u);
+        sdi12_sensor_process(&ctx, "0M!", 3);
+        TEST_ASSERT_EQUAL_STRING("00035\r\n", mock_response);
+        sdi12_sensor_measurement_done(&ctx, vals, 2);
+    }
+    TEST_ASSERT_EQUAL(4, mock_start_count);
+
+    /* Pre-measurement starts lead (3 s) + guard (0.5 s) before the poll */
+    sdi12_sensor_tick(&ctx, 36500);
+    TEST_ASSERT_EQUAL(5, mock_start_count);
+
+    /* Completion goes to the ring — no service request */
+    int sends = mock_send_count;
+    sdi12_value_t fresh[5] = {{7.5f, 1}, {8.0f, 0}, {1.0f, 0}, {2.0f, 0}, {3.0f, 0}};
+    sdi12_sensor_tick(&ctx, 39500);
+    sdi12_sensor_measurement_done(&ctx, fresh, 5);
+    TEST_ASSERT_EQUAL(sends, mock_send_count);
+
+    sdi12_sensor_tick(&ctx, 40000);
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    TEST_ASSERT_EQUAL_STRING("00005\r\n", mock_response);
+    TEST_ASSERT_EQUAL(5, mock_start_count);
+
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+7.5+8+1+2+3\r\n", mock_response);
+}
+
+void test_sensor_predict_late_adopts(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    ctx.cb.start_measurement = mock_start_3s;
+    mock_start_count = 0;
+    sdi12_sensor_set_prediction(&ctx, true, 0);
+
+    sdi12_value_t vals[1] = {{1.0f, 0}};
+    for (int i = 0; i < 4; i++) {
+        sdi12_sensor_tick(&ctx, (uint32_t)i * 10000u);
+        sdi12_sensor_process(&ctx, "0M!", 3);
+        sdi12_sensor_measurement_done(&ctx, vals, 1);
+    }
+
+    sdi12_sensor_tick(&ctx, 37000);
+    TEST_ASSERT_EQUAL(5, mock_start_count);
+
+    /* Poll arrives 1.2 s early — reply with the remaining 2 s */
+    sdi12_sensor_tick(&ctx, 38800);
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    TEST_ASSERT_EQUAL_STRING("00025\r\n", mock_response);
+    TEST_ASSERT_EQUAL(5, mock_start_count);
+    TEST_ASSERT_EQUAL(SDI12_STATE_MEASURING, ctx.state);
+
+    /* Completion is now a normal measurement — service request sent */
+    sdi12_sensor_measurement_done(&ctx, vals, 1);
+    TEST_ASSERT_EQUAL_STRING("0\r\n", mock_response);
+    TEST_ASSERT_EQUAL(1, sdi12_sensor_get_predict_stats(&ctx)->late);
+}
+
+static uint8_t mock_aborted;   /* group + 1, 0 = none */
+static bool mock_abort_ok;
+
+static bool mock_abort(uint8_t group, void *user_data)
+{
+    (void)user_data;
+    mock_aborted = (uint8_t)(group + 1);
+    return mock_abort_ok;
+}
+
+void test_sensor_predict_superseded_prefetch(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    sdi12_sensor_register_param(&ctx, 1, "WS", "m/s", 0);
+    ctx.cb.start_measurement = mock_start_3s;
+    mock_start_count = 0;
+    mock_aborted = 0;
+    sdi12_sensor_set_prediction(&ctx, true, 0);
+
+    sdi12_value_t vals[1] = {{1.0f, 0}};
+    for (int i = 0; i < 4; i++) {
+        sdi12_sensor_tick(&ctx, (uint32_t)i * 10000u);
+        sdi12_sensor_process(&ctx, "0M!", 3);
+        sdi12_sensor_measurement_done(&ctx, vals, 1);
+    }
+    sdi12_sensor_tick(&ctx, 37000);              /* group 0 prefetch starts */
+    TEST_ASSERT_EQUAL(5, mock_start_count);
+
+    /* No abort hook: group 1 starts behind the running prefetch */
+    sdi12_sensor_process(&ctx, "0M1!", 4);
+    TEST_ASSERT_EQUAL_STRING("00031\r\n", mock_response);
+    TEST_ASSERT_EQUAL(6, mock_start_count);
+
+    /* The first completion is the prefetch's: no service request */
+    int sends = mock_send_count;
+    sdi12_value_t pre[1] = {{555.0f, 0}};
+    sdi12_sensor_measurement_done(&ctx, pre, 1);
+    TEST_ASSERT_EQUAL(sends, mock_send_count);
+    TEST_ASSERT_EQUAL(SDI12_STATE_MEASURING, ctx.state);
+    TEST_ASSERT_FALSE(ctx.prefetch_pending);
+
+    /* The second finishes aM1! */
+    sdi12_value_t ws[1] = {{4.0f, 0}};
+    sdi12_sensor_measurement_done(&ctx, ws, 1);
+    TEST_ASSERT_EQUAL_STRING("0\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+4\r\n", mock_response);
+
+    /* The prefetch still answers the group 0 poll */
+    sdi12_sensor_tick(&ctx, 40000);
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    TEST_ASSERT_EQUAL_STRING("00005\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL(0, strncmp(mock_response, "0+555+", 6));
+
+    /* With an abort hook the next prefetch is stopped instead */
+    ctx.cb.abort_measurement = mock_abort;
+    mock_abort_ok = true;
+    sdi12_sensor_tick(&ctx, 47000);
+    TEST_ASSERT_TRUE(ctx.prefetch_pending);
+    sdi12_sensor_process(&ctx, "0M1!", 4);
+    TEST_ASSERT_EQUAL(1, mock_aborted);
+    TEST_ASSERT_FALSE(ctx.prefetch_pending);
+    TEST_ASSERT_EQUAL(SDI12_PREDICT_IDLE, ctx.predictors[0].state);
+    sdi12_sensor_measurement_done(&ctx, ws, 1);
+    TEST_ASSERT_EQUAL_STRING("0\r\n", mock_response);
+    TEST_ASSERT_EQUAL(SDI12_STATE_DATA_READY, ctx.state);
+}
+
+/* ── Shared Acquisition ─────────────────────────────────────────────────── */
+
+static uint8_t mock_start_group;
+
+static uint16_t mock_start_shared(uint8_t group, sdi12_meas_type_t type,
+                                  void *user_data)
+{
+    (void)type; (void)user_data;
+    mock_start_group = group;
+    mock_start_count++;
+    return 3;
+}
+
+void test_sensor_shared_sync(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    sdi12_sensor_register_param(&ctx, 1, "WS", "m/s", 1);   /* param 5 */
+    sdi12_sensor_register_param(&ctx, 2, "WD", "deg", 0);   /* param 6 */
+
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_set_shared_acquisition(&ctx, 0x007, 1000));
+
+    /* No tick clock yet: a snapshot cannot be aged, so none is reused */
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    sdi12_sensor_process(&ctx, "0M1!", 4);
+    TEST_ASSERT_EQUAL(14, mock_read_count);
+    mock_read_count = 0;
+    sdi12_sensor_tick(&ctx, 0);
+
+    /* One acquisition covers all three groups */
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    TEST_ASSERT_EQUAL_STRING("00005\r\n", mock_response);
+    TEST_ASSERT_EQUAL(7, mock_read_count);
+
+    sdi12_sensor_tick(&ctx, 900);
+    sdi12_sensor_process(&ctx, "0M1!", 4);
+    TEST_ASSERT_EQUAL_STRING("00001\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0C2!", 4);
+    TEST_ASSERT_EQUAL_STRING("000001\r\n", mock_response);
+    TEST_ASSERT_EQUAL(7, mock_read_count);
+
+    /* Snapshot expired — next command acquires again */
+    sdi12_sensor_tick(&ctx, 1100);
+    sdi12_sensor_process(&ctx, "0M2!", 4);
+    TEST_ASSERT_EQUAL(14, mock_read_count);
+
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_sensor_set_shared_acquisition(&ctx, 0x400, 1000));
+}
+
+void test_sensor_shared_async(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    sdi12_sensor_register_param(&ctx, 1, "WS", "m/s", 1);
+    sdi12_sensor_register_param(&ctx, 2, "WD", "deg", 0);
+    ctx.cb.start_measurement = mock_start_shared;
+    mock_start_count = 0;
+    sdi12_sensor_set_shared_acquisition(&ctx, 0x006, 5000);
+    sdi12_sensor_tick(&ctx, 0);
+
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_sensor_shared_done(&ctx, NULL, 0));
+
+    sdi12_sensor_process(&ctx, "0C1!", 4);
+    TEST_ASSERT_EQUAL_STRING("000301\r\n", mock_response);
+    TEST_ASSERT_EQUAL(SDI12_SHARED_GROUP, mock_start_group);
+
+    sdi12_value_t params[7] = {{0}};
+    params[5].value = 3.5f; params[5].decimals = 1;
+    params[6].value = 270.0f;
+    int sends = mock_send_count;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_shared_done(&ctx, params, 7));
+    TEST_ASSERT_EQUAL(sends, mock_send_count);   /* concurrent — no SR */
+    TEST_ASSERT_EQUAL(SDI12_STATE_DATA_READY, ctx.state);
+
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+3.5\r\n", mock_response);
+
+    /* Group 2 is served from the same hardware cycle */
+    sdi12_sensor_process(&ctx, "0M2!", 4);
+    TEST_ASSERT_EQUAL_STRING("00001\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+270\r\n", mock_response);
+    TEST_ASSERT_EQUAL(1, mock_start_count);
+
+    /* Uncovered group 0 still measures on its own */
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    TEST_ASSERT_EQUAL(0, mock_start_group);
+}
+
+void test_sensor_shared_with_prediction(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    sdi12_sensor_register_param(&ctx, 1, "WS", "m/s", 0);   /* param 5 */
+    ctx.cb.start_measurement = mock_start_shared;
+    mock_start_count = 0;
+    mock_aborted = 0;
+    sdi12_sensor_set_prediction(&ctx, true, 0);
+    sdi12_sensor_set_shared_acquisition(&ctx, 0x002, 1000);
+
+    sdi12_value_t vals[1] = {{1.0f, 0}};
+    for (int i = 0; i < 4; i++) {
+        sdi12_sensor_tick(&ctx, (uint32_t)i * 10000u);
+        sdi12_sensor_process(&ctx, "0M!", 3);
+        sdi12_sensor_measurement_done(&ctx, vals, 1);
+    }
+    sdi12_sensor_tick(&ctx, 37000);              /* group 0 prefetch starts */
+    TEST_ASSERT_TRUE(ctx.prefetch_pending);
+    TEST_ASSERT_EQUAL(0, mock_start_group);
+
+    /* A covered group starts the shared acquisition behind it */
+    sdi12_sensor_process(&ctx, "0M1!", 4);
+    TEST_ASSERT_EQUAL_STRING("00031\r\n", mock_response);
+    TEST_ASSERT_EQUAL(SDI12_SHARED_GROUP, mock_start_group);
+
+    /* The prefetch's completion fills group 0 only */
+    int sends = mock_send_count;
+    sdi12_value_t pre[1] = {{555.0f, 0}};
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_measurement_done(&ctx, pre, 1));
+    TEST_ASSERT_EQUAL(sends, mock_send_count);
+    TEST_ASSERT_EQUAL(SDI12_STATE_MEASURING, ctx.state);
+    TEST_ASSERT_FALSE(ctx.prefetch_pending);
+
+    /* The shared result has its own completion */
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_sensor_measurement_done(&ctx, pre, 1));
+    sdi12_value_t params[6] = {{0}};
+    params[5].value = 4.0f;
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_shared_done(&ctx, params, 6));
+    TEST_ASSERT_EQUAL_STRING("0\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+4\r\n", mock_response);
+
+    /* Group 0's poll is answered from its prefetch */
+    sdi12_sensor_tick(&ctx, 40000);
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    TEST_ASSERT_EQUAL_STRING("00005\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL(0, strncmp(mock_response, "0+555+", 6));
+
+    /* Prediction goes on; with an abort hook the shared start stops it */
+    ctx.cb.abort_measurement = mock_abort;
+    mock_abort_ok = true;
+    sdi12_sensor_tick(&ctx, 47000);
+    TEST_ASSERT_TRUE(ctx.prefetch_pending);
+    sdi12_sensor_process(&ctx, "0M1!", 4);
+    TEST_ASSERT_EQUAL(1, mock_aborted);
+    TEST_ASSERT_FALSE(ctx.prefetch_pending);
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_shared_done(&ctx, params, 6));
+    TEST_ASSERT_EQUAL(SDI12_STATE_DATA_READY, ctx.state);
+}
+
+/* ── Streaming Statistics ───────────────────────────────────────────────── */
+
+static const float stats_seq[] = {2, 4, 4, 4, 5, 5, 7, 9};
+static int stats_seq_pos;
+
+static sdi12_value_t mock_read_series(uint8_t param_index, void *user_data)
+{
+    if (param_index == 5) {
+        sdi12_value_t v = {stats_seq[stats_seq_pos++ % 8], 1};
+        return v;
+    }
+    return mock_read_param(param_index, user_data);
+}
+
+void test_sensor_stats_interval_report(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    ctx.cb.read_param = mock_read_series;
+    stats_seq_pos = 0;
+
+    sdi12_sensor_register_param(&ctx, 9, "WS", "m/s", 1);   /* param 5 */
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_register_stats(&ctx, 1, 5,
+        SDI12_STAT_MEAN | SDI12_STAT_MIN | SDI12_STAT_MAX |
+        SDI12_STAT_STDDEV | SDI12_STAT_COUNT, 1000));
+    TEST_ASSERT_EQUAL(5, sdi12_sensor_group_count(&ctx, 1));
+
+    for (uint32_t t = 0; t < 8000; t += 500) {
+        sdi12_sensor_tick(&ctx, t);                 /* samples every 1 s */
+    }
+    TEST_ASSERT_EQUAL(8, stats_seq_pos);
+
+    /* aR1! reports the interval so far without closing it */
+    sdi12_sensor_process(&ctx, "0R1!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+5.0+2.0+9.0+2.1+8\r\n", mock_response);
+
+    sdi12_sensor_process(&ctx, "0M1!", 4);
+    TEST_ASSERT_EQUAL_STRING("00005\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+5.0+2.0+9.0+2.1+8\r\n", mock_response);
+
+    /* aM1! started a new interval */
+    sdi12_sensor_process(&ctx, "0R1!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+0.0+0.0+0.0+0.0+0\r\n", mock_response);
+}
+
+void test_sensor_stats_registration_limits(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_sensor_register_stats(&ctx, 1, 5, SDI12_STAT_MEAN, 1000));
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_sensor_register_stats(&ctx, 1, 0, 0x20, 1000));
+
+    /* A statistic cannot itself be a source */
+    sdi12_sensor_register_stats(&ctx, 1, 0, SDI12_STAT_MEAN, 1000);
+    TEST_ASSERT_EQUAL(SDI12_ERR_INVALID_COMMAND,
+                      sdi12_sensor_register_stats(&ctx, 2, 5, SDI12_STAT_MAX, 1000));
+
+    /* 5 + 1 params used; 15 more would overflow SDI12_MAX_PARAMS */
+    for (uint8_t i = 6; i < SDI12_MAX_PARAMS - 1; i++) {
+        sdi12_sensor_register_param(&ctx, 3, "XX", "u", 0);
+    }
+    TEST_ASSERT_EQUAL(SDI12_ERR_PARAM_LIMIT,
+                      sdi12_sensor_register_stats(&ctx, 2, 1,
+                          SDI12_STAT_MIN | SDI12_STAT_MAX, 1000));
+}
+
+/* ── Sample History ─────────────────────────────────────────────────────── */
+
+void test_sensor_history_select_and_download(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    sdi12_history_rec_t recs[16];
+
+    TEST_ASSERT_EQUAL(SDI12_OK, sdi12_sensor_attach_history(&ctx, 1, recs, 16, 1000));
+    for (uint32_t t = 0; t <= 9000; t += 1000) {
+        sdi12_sensor_tick(&ctx, t);
+    }
+    TEST_ASSERT_EQUAL(10, ctx.history[0].count);
+
+    /* Three records, skipping the two newest: taken at 5, 6, 7 s */
+    sdi12_sensor_process(&ctx, "0XHIST1,2,3!", 12);
+    TEST_ASSERT_EQUAL_STRING("0+3\r\n", mock_response);
+
+    /* Recording goes on into free slots; the selection does not move */
+    sdi12_sensor_tick(&ctx, 10000);
+    TEST_ASSERT_EQUAL(11, ctx.history[0].count);
+    TEST_ASSERT_EQUAL(0, ctx.history[0].dropped);
+
+    sdi12_sensor_process(&ctx, "0HA!", 4);
+    TEST_ASSERT_EQUAL_STRING("0000006\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+4+25.50+3+25.50+2+25.50\r\n", mock_response);
+
+    /* A break mid-download (master idle > 87 ms) keeps the selection */
+    sdi12_sensor_break(&ctx);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+4+25.50+3+25.50+2+25.50\r\n", mock_response);
+
+    /* Same selection as FLOAT32 pairs */
+    sdi12_sensor_process(&ctx, "0HB!", 4);
+    TEST_ASSERT_EQUAL_STRING("0000006\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0DB0!", 5);
+    TEST_ASSERT_EQUAL(4 + 24 + 2, mock_response_len);
+    TEST_ASSERT_EQUAL(24, (uint8_t)mock_response[1]);
+    TEST_ASSERT_EQUAL(SDI12_BINTYPE_FLOAT32, mock_response[3]);
+    float age;
+    memcpy(&age, mock_response + 4, sizeof(age));   /* LE host assumed */
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, age);
+
+    /* A normal measurement closes the download and resumes recording */
+    sdi12_sensor_process(&ctx, "0M!", 3);
+    sdi12_sensor_tick(&ctx, 11000);
+    TEST_ASSERT_EQUAL(12, ctx.history[0].count);
+}
+
+void test_sensor_history_bulk_pages(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    static sdi12_history_rec_t recs[600];
+
+    sdi12_sensor_attach_history(&ctx, 1, recs, 600, 1000);
+    for (uint32_t t = 0; t < 700; t++) {
+        sdi12_sensor_tick(&ctx, t * 1000u);          /* ring wraps */
+    }
+    TEST_ASSERT_EQUAL(600, ctx.history[0].count);
+
+    sdi12_sensor_process(&ctx, "0XHIST1,0,999!", 14);
+    TEST_ASSERT_EQUAL_STRING("0+499\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0HA!", 4);
+    TEST_ASSERT_EQUAL_STRING("0000998\r\n", mock_response);
+
+    /* Walk every D page until an empty one */
+    int values = 0;
+    char cmd[8];
+    uint16_t page;
+    for (page = 0; page < 999; page++) {
+        int n = snprintf(cmd, sizeof(cmd), "0D%u!", page);
+        sdi12_sensor_process(&ctx, cmd, (size_t)n);
+        if (strcmp(mock_response, "0\r\n") == 0) break;
+        TEST_ASSERT_TRUE(strlen(mock_response) <= 1 + SDI12_C_VALUES_MAX_CHARS + 2);
+        for (const char *c = mock_response; *c; c++) {
+            if (*c == '+' || *c == '-') values++;
+        }
+    }
+    TEST_ASSERT_EQUAL(998, values);
+    TEST_ASSERT_TRUE(page > 10);
+
+    /* Oldest record first: 498 s old; repeat requests are stable */
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL(0, strncmp(mock_response, "0+498+25.50", 11));
+    sdi12_sensor_process(&ctx, "0D5!", 4);
+    char first[96];
+    strcpy(first, mock_response);
+    sdi12_sensor_process(&ctx, "0D5!", 4);
+    TEST_ASSERT_EQUAL_STRING(first, mock_response);
+
+    /* The 101 unselected slots fill up while the logger re-reads a page */
+    for (uint32_t t = 700; t < 801; t++) {
+        sdi12_sensor_tick(&ctx, t * 1000u);
+        if (t % 10 == 0) {
+            sdi12_sensor_process(&ctx, "0D5!", 4);
+            TEST_ASSERT_EQUAL_STRING(first, mock_response);
+        }
+    }
+    TEST_ASSERT_EQUAL(1, ctx.hist_sel);
+
+    /* Every page has been read: the next sample reclaims the selection */
+    sdi12_sensor_tick(&ctx, 801000u);
+    TEST_ASSERT_EQUAL(0, ctx.hist_sel);
+    TEST_ASSERT_EQUAL(0, ctx.history[0].dropped);
+    TEST_ASSERT_EQUAL(600, ctx.history[0].count);
+}
+
+void test_sensor_history_selection_bounded(void)
+{
+    reset_mocks();
+    sdi12_sensor_ctx_t ctx = create_test_ctx('0');
+    sdi12_history_rec_t recs[4];
+
+    sdi12_sensor_attach_history(&ctx, 1, recs, 4, 1000);
+    for (uint32_t t = 0; t < 4; t++) sdi12_sensor_tick(&ctx, t * 1000u);
+
+    /* The whole ring selected and read: recording carries straight on */
+    sdi12_sensor_process(&ctx, "0XHIST1,0,4!", 12);
+    TEST_ASSERT_EQUAL_STRING("0+4\r\n", mock_response);
+    sdi12_sensor_process(&ctx, "0HA!", 4);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    for (uint32_t t = 4; t < 100; t++) sdi12_sensor_tick(&ctx, t * 1000u);
+    TEST_ASSERT_EQUAL(0, ctx.history[0].dropped);
+
+    /* The next pull gets the newest records, not the ones read before */
+    sdi12_sensor_process(&ctx, "0XHIST1,0,4!", 12);
+    sdi12_sensor_process(&ctx, "0HA!", 4);
+    sdi12_sensor_process(&ctx, "0D0!", 4);
+    TEST_ASSERT_EQUAL_STRING("0+3+25.50+2+25.50+1+25.50+0+25.50\r\n", mock_response);
+
+    /* Selected but never read: held for SDI12_HISTORY_HOLD_MS, then released */
+    sdi12_sensor_process(&ctx, "0XHIST1,0,4!", 12);
+    for (uint32_t t = 100; t < 200; t++) sdi12_sensor_tick(&ctx, t * 1000u);
+    TEST_ASSERT_EQUAL(0, ctx.hist_sel);
+    TEST_ASSERT_EQUAL(SDI12_HISTORY_HOLD_MS / 1000u - 1u, ctx.history[0].dropped);
+    TEST_ASSERT_EQUAL(4, ctx.history[0].count);
+}